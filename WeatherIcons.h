@@ -387,7 +387,7 @@ static const uint8_t ICON_FOG_NIGHT[] PROGMEM = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 };
 
-static inline const uint8_t* weatherIconBitmap(int code, const String& desc, bool isNight) {
+static inline const uint8_t* weatherIconBitmap(int code, const char* desc, bool isNight) {
   if (code >= 200 && code <= 232) return isNight ? ICON_THUNDERSTORMS_NIGHT : ICON_THUNDERSTORMS_DAY;
   if (code >= 300 && code <= 531) return isNight ? ICON_OVERCAST_NIGHT_RAIN : ICON_OVERCAST_DAY_RAIN;
   if (code >= 600 && code <= 622) return isNight ? ICON_OVERCAST_NIGHT_SNOW : ICON_OVERCAST_DAY_SNOW;
@@ -396,15 +396,17 @@ static inline const uint8_t* weatherIconBitmap(int code, const String& desc, boo
   if (code == 801 || code == 802) return isNight ? ICON_PARTLY_CLOUDY_NIGHT : ICON_PARTLY_CLOUDY_DAY;
   if (code >= 803 && code <= 804) return isNight ? ICON_OVERCAST_NIGHT : ICON_OVERCAST_DAY;
 
-  String d = desc;
-  d.toLowerCase();
-  if (d.indexOf("thunder") >= 0 || d.indexOf("storm") >= 0) return isNight ? ICON_THUNDERSTORMS_NIGHT : ICON_THUNDERSTORMS_DAY;
-  if (d.indexOf("rain") >= 0 || d.indexOf("drizzle") >= 0) return isNight ? ICON_OVERCAST_NIGHT_RAIN : ICON_OVERCAST_DAY_RAIN;
-  if (d.indexOf("snow") >= 0) return isNight ? ICON_OVERCAST_NIGHT_SNOW : ICON_OVERCAST_DAY_SNOW;
-  if (d.indexOf("mist") >= 0 || d.indexOf("fog") >= 0 || d.indexOf("haze") >= 0 || d.indexOf("smoke") >= 0) return isNight ? ICON_FOG_NIGHT : ICON_FOG_DAY;
-  if (d.indexOf("clear") >= 0) return isNight ? ICON_CLEAR_NIGHT : ICON_CLEAR_DAY;
-  if (d.indexOf("few cloud") >= 0 || d.indexOf("scattered") >= 0) return isNight ? ICON_PARTLY_CLOUDY_NIGHT : ICON_PARTLY_CLOUDY_DAY;
-  if (d.indexOf("cloud") >= 0 || d.indexOf("overcast") >= 0) return isNight ? ICON_OVERCAST_NIGHT : ICON_OVERCAST_DAY;
+  char d[64]; // Lowercased copy of desc, on the stack
+  size_t n = 0;
+  for (; desc[n] && n < sizeof(d) - 1; n++) d[n] = (char)tolower((uint8_t)desc[n]);
+  d[n] = '\0';
+  if (strstr(d, "thunder") || strstr(d, "storm")) return isNight ? ICON_THUNDERSTORMS_NIGHT : ICON_THUNDERSTORMS_DAY;
+  if (strstr(d, "rain") || strstr(d, "drizzle")) return isNight ? ICON_OVERCAST_NIGHT_RAIN : ICON_OVERCAST_DAY_RAIN;
+  if (strstr(d, "snow")) return isNight ? ICON_OVERCAST_NIGHT_SNOW : ICON_OVERCAST_DAY_SNOW;
+  if (strstr(d, "mist") || strstr(d, "fog") || strstr(d, "haze") || strstr(d, "smoke")) return isNight ? ICON_FOG_NIGHT : ICON_FOG_DAY;
+  if (strstr(d, "clear")) return isNight ? ICON_CLEAR_NIGHT : ICON_CLEAR_DAY;
+  if (strstr(d, "few cloud") || strstr(d, "scattered")) return isNight ? ICON_PARTLY_CLOUDY_NIGHT : ICON_PARTLY_CLOUDY_DAY;
+  if (strstr(d, "cloud") || strstr(d, "overcast")) return isNight ? ICON_OVERCAST_NIGHT : ICON_OVERCAST_DAY;
 
   return nullptr;
 }
@@ -0,0 +1,44 @@
+// countdown_cycle.h - Which countdown the cycle shows, and when it moves on to the next one.
+//
+// The state is a few words so it can be kept in the deep-sleep RTC record (SleepState in
+// parkpal.ino): a timer wake picks the cycle up where the previous wake left it. It records the
+// display mode it was built in, so it is only started over when the mode really changes, not on
+// the first refresh of every wake. Times are Unix seconds.
+
+#pragma once
+
+#include <stdint.h>
+
+enum CountdownCycleMode : uint8_t { CYCLE_MODE_NONE, CYCLE_MODE_PARKS, CYCLE_MODE_COUNTDOWN };
+
+struct CountdownCycle {
+    uint8_t mode = CYCLE_MODE_NONE; // Display mode the state belongs to (NONE after power-on)
+    int32_t index = 0;              // Position among the countdowns included in the cycle
+    uint32_t rotateAt = 0;          // When the next countdown comes up (0 = not scheduled)
+};
+
+// Starts the cycle over if the display mode is not the one the state was built in.
+static inline void countdownCycleEnterMode(CountdownCycle& c, CountdownCycleMode mode) {
+    if (c.mode == mode) return;
+    c = CountdownCycle();
+    c.mode = mode;
+}
+
+// Position to show among `n` countdowns at `now` (a set clock). Steps to the next one once the
+// scheduled instant has passed and schedules the step after it `period` seconds on; the first
+// call only schedules.
+static inline int countdownCycleStep(CountdownCycle& c, int64_t now, int64_t period, int n) {
+    if (!c.rotateAt) {
+        c.rotateAt = (uint32_t)(now + period);
+    } else if (now >= (int64_t)c.rotateAt) {
+        c.index = (c.index + 1) % n;
+        c.rotateAt = (uint32_t)(now + period);
+    }
+    return c.index % n;
+}
+
+// The instant the countdown frame next changes: the scheduled step, or `midnight` (the next local
+// midnight, when the day count changes) if that comes first.
+static inline int64_t countdownCycleNextChange(const CountdownCycle& c, int64_t midnight) {
+    return c.rotateAt && (int64_t)c.rotateAt < midnight ? (int64_t)c.rotateAt : midnight;
+}
@@ -0,0 +1,154 @@
+// display_list.h - Record-once list of drawing primitives, replayed per page band.
+//
+// In paged mode GxEPD2 runs a frame's drawing code once per PAGE_H-line band, so anything computed
+// while drawing (text measurement, clipping, font fitting) is repeated for every page. Render
+// functions instead lay the frame out once into a DisplayList: each primitive is stored with its
+// resolved position, font and colour plus a bounding box. replay() then draws only the primitives
+// that intersect the band currently being drawn.
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <string.h>
+
+class DisplayList {
+public:
+    static const int MAX_OPS = 128;
+    static const size_t TEXT_BYTES = 2048; // All text runs of one frame, NUL-terminated
+
+    void clear() {
+        n_ = 0;
+        textUsed_ = 0;
+        dropped_ = 0;
+    }
+
+    int size() const { return n_; }
+    int dropped() const { return dropped_; } // Primitives that didn't fit; they are not drawn
+
+    // Text at the cursor position (x, baseline y), with the caller's bounding box (inclusive).
+    void text(int16_t x, int16_t y, const char* s, const GFXfont* f, uint16_t color,
+              int16_t bx0, int16_t by0, int16_t bx1, int16_t by1) {
+        const size_t len = strlen(s);
+        if (!len) return;
+        if (textUsed_ + len + 1 > TEXT_BYTES) {
+            dropped_++;
+            return;
+        }
+        Op* op = add(OP_TEXT, color, bx0, by0, bx1, by1);
+        if (!op) return;
+        memcpy(text_ + textUsed_, s, len + 1);
+        op->a[0] = x;
+        op->a[1] = y;
+        op->a[2] = (int16_t)textUsed_;
+        op->ptr = f;
+        textUsed_ += len + 1;
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        if (w <= 0 || h <= 0) return;
+        if (Op* op = add(OP_FILL_RECT, color, x, y, x + w - 1, y + h - 1)) setArgs(op, x, y, w, h);
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { fillRect(x, y, 1, h, color); }
+
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        if (Op* op = add(OP_LINE, color, min2(x0, x1), min2(y0, y1), max2(x0, x1), max2(y0, y1)))
+            setArgs(op, x0, y0, x1, y1);
+    }
+
+    void fillCircle(int16_t cx, int16_t cy, int16_t r, uint16_t color) {
+        if (Op* op = add(OP_FILL_CIRCLE, color, cx - r, cy - r, cx + r, cy + r)) setArgs(op, cx, cy, r);
+    }
+
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+        if (Op* op = add(OP_FILL_TRIANGLE, color, min2(x0, min2(x1, x2)), min2(y0, min2(y1, y2)),
+                         max2(x0, max2(x1, x2)), max2(y0, max2(y1, y2))))
+            setArgs(op, x0, y0, x1, y1, x2, y2);
+    }
+
+    // 1-bit bitmap (PROGMEM); it must outlive the list.
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bmp, int16_t w, int16_t h, uint16_t color) {
+        if (Op* op = add(OP_BITMAP, color, x, y, x + w - 1, y + h - 1)) {
+            setArgs(op, x, y, w, h);
+            op->ptr = bmp;
+        }
+    }
+
+    // Draws, in recording order, every primitive whose bounds intersect the given rectangle.
+    void replay(Adafruit_GFX& gfx, int16_t x, int16_t y, int16_t w, int16_t h) const {
+        const int16_t x1 = x + w - 1, y1 = y + h - 1;
+        for (int i = 0; i < n_; i++) {
+            const Op& op = ops_[i];
+            if (op.x1 < x || op.x0 > x1 || op.y1 < y || op.y0 > y1) continue;
+            const int16_t* a = op.a;
+            switch (op.kind) {
+            case OP_TEXT:
+                gfx.setFont((const GFXfont*)op.ptr);
+                gfx.setTextColor(op.color);
+                gfx.setCursor(a[0], a[1]);
+                gfx.print(text_ + a[2]);
+                break;
+            case OP_FILL_RECT:
+                gfx.fillRect(a[0], a[1], a[2], a[3], op.color);
+                break;
+            case OP_LINE:
+                gfx.drawLine(a[0], a[1], a[2], a[3], op.color);
+                break;
+            case OP_FILL_CIRCLE:
+                gfx.fillCircle(a[0], a[1], a[2], op.color);
+                break;
+            case OP_FILL_TRIANGLE:
+                gfx.fillTriangle(a[0], a[1], a[2], a[3], a[4], a[5], op.color);
+                break;
+            case OP_BITMAP:
+                gfx.drawBitmap(a[0], a[1], (const uint8_t*)op.ptr, a[2], a[3], op.color);
+                break;
+            }
+        }
+    }
+
+private:
+    enum OpKind : uint8_t { OP_TEXT, OP_FILL_RECT, OP_LINE, OP_FILL_CIRCLE, OP_FILL_TRIANGLE, OP_BITMAP };
+
+    struct Op {
+        OpKind kind;
+        uint16_t color;
+        int16_t x0, y0, x1, y1; // Bounding box, inclusive
+        int16_t a[6];           // Primitive arguments (text: cursor x, y, text offset)
+        const void* ptr;        // Font or bitmap
+    };
+
+    static int16_t min2(int16_t a, int16_t b) { return a < b ? a : b; }
+    static int16_t max2(int16_t a, int16_t b) { return a > b ? a : b; }
+
+    static void setArgs(Op* op, int16_t a0, int16_t a1, int16_t a2, int16_t a3 = 0, int16_t a4 = 0, int16_t a5 = 0) {
+        op->a[0] = a0;
+        op->a[1] = a1;
+        op->a[2] = a2;
+        op->a[3] = a3;
+        op->a[4] = a4;
+        op->a[5] = a5;
+    }
+
+    Op* add(OpKind kind, uint16_t color, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+        if (n_ >= MAX_OPS) {
+            dropped_++;
+            return nullptr;
+        }
+        Op* op = &ops_[n_++];
+        op->kind = kind;
+        op->color = color;
+        op->x0 = x0;
+        op->y0 = y0;
+        op->x1 = x1;
+        op->y1 = y1;
+        op->ptr = nullptr;
+        return op;
+    }
+
+    Op ops_[MAX_OPS];
+    char text_[TEXT_BYTES];
+    size_t textUsed_ = 0;
+    int n_ = 0;
+    int dropped_ = 0;
+};
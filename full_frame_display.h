@@ -0,0 +1,131 @@
+// full_frame_display.h - GxEPD2_3C with an optional full-frame (PSRAM) render mode.
+//
+// GxEPD2_3C draws through a page_height-line window, so a frame's drawing code runs once per page
+// band (9 passes for the 528-line panel at 64 lines). On boards with PSRAM, enableFullFrame()
+// allocates both colour planes for the whole panel; firstPage()/nextPage() then run the drawing
+// code once and push the frame with a single writeImage + refresh. Until it is enabled (or on
+// boards without PSRAM) everything behaves exactly like GxEPD2_3C.
+
+#pragma once
+
+#include <GxEPD2_3C.h>
+#include <esp32-hal-psram.h>
+#include <algorithm>
+#include <utility>
+
+template <typename GxEPD2_Type, const uint16_t page_height>
+class FullFrameDisplay : public GxEPD2_3C<GxEPD2_Type, page_height> {
+    using Base = GxEPD2_3C<GxEPD2_Type, page_height>;
+
+public:
+    static const size_t PLANE_BYTES = (size_t)(GxEPD2_Type::WIDTH / 8) * GxEPD2_Type::HEIGHT;
+
+    explicit FullFrameDisplay(GxEPD2_Type epd2_instance) : Base(epd2_instance) {}
+
+    // Switches to full-frame rendering; false (and still paging) when the planes can't be allocated.
+    bool enableFullFrame() {
+        if (!black_) {
+            if (!psramFound()) return false;
+            black_ = (uint8_t*)ps_malloc(PLANE_BYTES);
+            color_ = (uint8_t*)ps_malloc(PLANE_BYTES);
+            if (!black_ || !color_) {
+                free(black_);
+                free(color_);
+                black_ = color_ = nullptr;
+                return false;
+            }
+        }
+        full_ = true;
+        return true;
+    }
+
+    void disableFullFrame() { full_ = false; }
+    bool fullFrame() const { return full_; }
+
+    void fillScreen(uint16_t color) override {
+        if (!full_) return Base::fillScreen(color);
+        bool black, red;
+        planesFor(color, black, red);
+        memset(black_, black ? 0x00 : 0xFF, PLANE_BYTES);
+        memset(color_, red ? 0x00 : 0xFF, PLANE_BYTES);
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (!full_) return Base::drawPixel(x, y, color);
+        if (x < 0 || x >= this->width() || y < 0 || y >= this->height()) return;
+        // Same rotation mapping as GxEPD2_3C::drawPixel
+        switch (this->getRotation()) {
+            case 1:
+                std::swap(x, y);
+                x = GxEPD2_Type::WIDTH - x - 1;
+                break;
+            case 2:
+                x = GxEPD2_Type::WIDTH - x - 1;
+                y = GxEPD2_Type::HEIGHT - y - 1;
+                break;
+            case 3:
+                std::swap(x, y);
+                y = GxEPD2_Type::HEIGHT - y - 1;
+                break;
+        }
+        const size_t i = x / 8 + (size_t)y * (GxEPD2_Type::WIDTH / 8);
+        const uint8_t bit = 1 << (7 - x % 8);
+        bool black, red;
+        planesFor(color, black, red);
+        black_[i] = black ? (black_[i] & ~bit) : (black_[i] | bit);
+        color_[i] = red ? (color_[i] & ~bit) : (color_[i] | bit);
+    }
+
+    // Callers use the usual `firstPage(); do { ... } while (nextPage());` loop; in full-frame mode it
+    // runs once.
+    void firstPage() {
+        page_ = 0;
+        if (!full_) return Base::firstPage();
+        fillScreen(GxEPD_WHITE);
+    }
+
+    bool nextPage() {
+        if (!full_) {
+            const bool more = Base::nextPage();
+            page_ = more ? page_ + 1 : 0;
+            return more;
+        }
+        this->epd2.writeImage(black_, color_, 0, 0, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT);
+        this->epd2.refresh(false);
+        this->epd2.powerOff();
+        return false;
+    }
+
+    // The area, in rotated (drawing) coordinates, that the current page can change: one page band
+    // of a full-window update, or the whole panel in full-frame mode.
+    void pageRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
+        x = y = 0;
+        w = this->width();
+        h = this->height();
+        if (full_) return;
+        const int16_t top = page_ * page_height;
+        const int16_t bottom = std::min<int16_t>(top + page_height, GxEPD2_Type::HEIGHT); // Exclusive
+        switch (this->getRotation()) {
+            case 0: y = top; h = bottom - top; break;
+            case 1: x = top; w = bottom - top; break;
+            case 2: y = GxEPD2_Type::HEIGHT - bottom; h = bottom - top; break;
+            case 3: x = GxEPD2_Type::HEIGHT - bottom; w = bottom - top; break;
+        }
+    }
+
+private:
+    // Plane bits are active-low; same colour reduction as GxEPD2_3C.
+    static void planesFor(uint16_t color, bool& black, bool& red) {
+        black = red = false;
+        if (color == GxEPD_WHITE) return;
+        if (color == GxEPD_BLACK) black = true;
+        else if (color == GxEPD_RED || color == GxEPD_YELLOW) red = true;
+        else if ((color & 0xF100) > (0xF100 / 2)) red = true;
+        else if ((((color & 0xF100) >> 11) + ((color & 0x07E0) >> 5) + (color & 0x001F)) < 3 * 255 / 2) black = true;
+    }
+
+    uint8_t* black_ = nullptr;
+    uint8_t* color_ = nullptr;
+    bool full_ = false;
+    int16_t page_ = 0; // Page being drawn between firstPage() and the last nextPage()
+};
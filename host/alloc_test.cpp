@@ -0,0 +1,133 @@
+// alloc_test.cpp - Checks that the steady-state refresh path never touches the heap.
+//
+// malloc, calloc, realloc and free are replaced with counting wrappers around glibc's own
+// (__libc_malloc and friends; operator new goes through malloc). After one warm-up pass, each step
+// of a refresh runs with counting on: decoding a binary summary, copying the RuntimeConfig
+// snapshot, laying out every scene (scenes.h) and replaying it into the panel paged and
+// full-frame, and the skip when the frame is already on the panel. Any allocation fails the test.
+
+#include "render_env.h"
+
+#include "render.h"
+
+#include "scenes.h"
+
+#include <vector>
+
+extern "C" {
+void* __libc_malloc(size_t n);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* p, size_t n);
+void __libc_free(void* p);
+
+static bool counting = false;
+static long allocations = 0;
+
+void* malloc(size_t n) {
+    if (counting) allocations++;
+    return __libc_malloc(n);
+}
+
+void* calloc(size_t n, size_t size) {
+    if (counting) allocations++;
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* p, size_t n) {
+    if (counting) allocations++;
+    return __libc_realloc(p, n);
+}
+
+void free(void* p) {
+    if (counting && p) allocations++;
+    __libc_free(p);
+}
+}
+
+static int failures = 0;
+
+// Runs `step` once to warm up (first-use caches such as the font metrics), then again counting.
+template <typename F>
+static void expectNoAllocations(const char* name, F step) {
+    step();
+    allocations = 0;
+    counting = true;
+    step();
+    counting = false;
+    if (allocations) {
+        printf("FAIL %s: %ld heap calls\n", name, allocations);
+        failures++;
+    } else {
+        printf("ok %s\n", name);
+    }
+}
+
+// A version 2 "PPS" record with a full ride list, laid out as in summary_codec.h.
+static std::vector<uint8_t> summaryRecord() {
+    std::vector<uint8_t> b;
+    const auto u8 = [&](uint32_t v) { b.push_back((uint8_t)v); };
+    const auto u16 = [&](uint32_t v) { u8(v); u8(v >> 8); };
+    const auto u32 = [&](uint32_t v) { u16(v); u16(v >> 16); };
+    const auto str = [&](const char* s) {
+        u8(strlen(s));
+        b.insert(b.end(), s, s + strlen(s));
+    };
+    u8('P');
+    u8('P');
+    u8('S');
+    u8(SUMMARY_BIN_VERSION);
+    u8(1);
+    u8(SUMMARY_MAX_RIDES);
+    u16(27);
+    u16(800);
+    u32(1767268800);
+    u32(1767310000);
+    u32(1767270000);
+    u16(9 * 60);
+    u16(22 * 60);
+    u8(1);
+    u8(12);
+    str("clear sky");
+    for (size_t i = 0; i < SUMMARY_MAX_RIDES; i++) {
+        u32(100 + i);
+        u16(5 * i);
+        u8(i & 1);
+        str("Seven Dwarfs Mine Train");
+    }
+    return b;
+}
+
+int main() {
+    display.setRotation(4); // As in setup()
+
+    const std::vector<uint8_t> record = summaryRecord();
+    static ParkSummary decoded;
+    expectNoAllocations("decodeSummaryBin", [&] {
+        if (!decodeSummaryBin(record.data(), record.size(), decoded)) {
+            printf("FAIL decodeSummaryBin: record rejected\n");
+            failures++;
+        }
+    });
+
+    static RuntimeConfig config, snapshot;
+    config.parks_n = 2;
+    config.trip_name = "Spring Break";
+    expectNoAllocations("RuntimeConfig copy", [] { snapshot = config; });
+
+    for (const Scene& scene : SCENES) {
+        for (bool fullFrame : { false, true }) {
+            if (fullFrame) display.enableFullFrame();
+            else display.disableFullFrame();
+            char name[64];
+            snprintf(name, sizeof name, "%s (%s)", scene.name, fullFrame ? "full frame" : "paged");
+            expectNoAllocations(name, [&] {
+                forgetFrame();
+                scene.draw();
+            });
+        }
+        char name[64];
+        snprintf(name, sizeof name, "%s (already on panel)", scene.name);
+        expectNoAllocations(name, [&] { scene.draw(); });
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,63 @@
+// countdown_cycle_test.cpp - Checks that the countdown cycle (countdown_cycle.h) survives deep sleep.
+//
+// Each simulated wake does what a timer wake of the firmware does: restore the state from the RTC
+// record (restoreSleepState()), run one countdown refresh (runRefresh()) and store it back before
+// sleeping (enterDeepSleep()). The cycle must step on the wake at its scheduled instant and keep
+// its place on the wakes between, and only a real mode change may start it over. The last run wakes
+// only when the previous wake scheduled it, as scheduleCountdownTick() does.
+
+#include <stdio.h>
+
+#include "countdown_cycle.h"
+
+static const int64_t T0 = 1767268800; // 2026-01-01 12:00 UTC
+static const int64_t PERIOD = 3 * 300; // cycle_every_n_refreshes = 3 at REFRESH_MS = 5 min
+static const int64_t SLACK = 5;         // COUNTDOWN_TICK_SLACK_MS
+static const int COUNTDOWNS = 3;
+
+static int failures = 0;
+static CountdownCycle rtc; // SleepState::countdownCycle; zeroed at power-on
+
+// One wake at `now` in `mode`: returns the countdown shown.
+static int wake(int64_t now, CountdownCycleMode mode) {
+    CountdownCycle cycle = rtc;
+    countdownCycleEnterMode(cycle, mode);
+    const int pick = mode == CYCLE_MODE_COUNTDOWN ? countdownCycleStep(cycle, now, PERIOD, COUNTDOWNS) : -1;
+    rtc = cycle;
+    return pick;
+}
+
+static void expect(const char* what, int got, int want) {
+    if (got == want) {
+        printf("ok %s\n", what);
+    } else {
+        printf("FAIL %s: countdown %d, expected %d\n", what, got, want);
+        failures++;
+    }
+}
+
+int main() {
+    expect("power-on shows the first countdown", wake(T0, CYCLE_MODE_COUNTDOWN), 0);
+    expect("a wake before the step keeps it", wake(T0 + PERIOD / 2, CYCLE_MODE_COUNTDOWN), 0);
+    expect("the wake at the first step moves on", wake(T0 + PERIOD + SLACK, CYCLE_MODE_COUNTDOWN), 1);
+    expect("the wake at the second step moves on", wake(T0 + 2 * PERIOD + 2 * SLACK, CYCLE_MODE_COUNTDOWN), 2);
+    expect("the cycle wraps around", wake(T0 + 3 * PERIOD + 3 * SLACK, CYCLE_MODE_COUNTDOWN), 0);
+
+    wake(T0 + 4 * PERIOD, CYCLE_MODE_PARKS);
+    expect("a mode change starts the cycle over", wake(T0 + 5 * PERIOD, CYCLE_MODE_COUNTDOWN), 0);
+    expect("and it steps again after that", wake(T0 + 6 * PERIOD + SLACK, CYCLE_MODE_COUNTDOWN), 1);
+
+    // Each wake at the instant the previous one scheduled (scheduleCountdownTick()), with local
+    // midnight falling between two steps: the midnight wake keeps the countdown, the others step.
+    rtc = CountdownCycle();
+    const int64_t midnight = T0 + 2 * PERIOD + PERIOD / 3;
+    static const int WANT[] = { 0, 1, 2, 2, 0, 1 };
+    int64_t now = T0;
+    for (int i = 0; i < (int)(sizeof WANT / sizeof WANT[0]); i++) {
+        char what[64];
+        snprintf(what, sizeof what, "scheduled wake %d", i);
+        expect(what, wake(now, CYCLE_MODE_COUNTDOWN), WANT[i]);
+        now = countdownCycleNextChange(rtc, now < midnight ? midnight : midnight + 86400) + SLACK;
+    }
+    return failures ? 1 : 0;
+}
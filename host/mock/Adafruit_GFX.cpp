@@ -0,0 +1,224 @@
+// Adafruit_GFX.cpp - Host rasteriser for Adafruit_GFX.h; each routine follows the library's
+// algorithm (Bresenham lines, midpoint circles, scanline triangles, GFXfont glyph walks).
+
+#include <Adafruit_GFX.h>
+
+#include <utility>
+
+void Adafruit_GFX::setRotation(uint8_t r) {
+    rotation = r & 3;
+    _width = (rotation & 1) ? HEIGHT : WIDTH;
+    _height = (rotation & 1) ? WIDTH : HEIGHT;
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    const bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    const int16_t dx = x1 - x0, dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    const int16_t ystep = y0 < y1 ? 1 : -1;
+    for (; x0 <= x1; x0++) {
+        if (steep) drawPixel(y0, x0, color);
+        else drawPixel(x0, y0, color);
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    drawLine(x, y, x, y + h - 1, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    drawLine(x, y, x + w - 1, y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = x; i < x + w; i++) drawFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    drawFastVLine(x0, y0 - r, 2 * r + 1, color);
+    fillCircleHelper(x0, y0, r, 3, 0, color);
+}
+
+void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta, uint16_t color) {
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r, px = x, py = y;
+    delta++; // Avoid some +1's in the loop
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        // These checks avoid double-drawing certain lines
+        if (x < (y + 1)) {
+            if (corners & 1) drawFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+            if (corners & 2) drawFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+        }
+        if (y != py) {
+            if (corners & 1) drawFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+            if (corners & 2) drawFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+            py = y;
+        }
+        px = x;
+    }
+}
+
+void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    int16_t a, b, y, last;
+    // Sort coordinates by Y order (y2 >= y1 >= y0)
+    if (y0 > y1) {
+        std::swap(y0, y1);
+        std::swap(x0, x1);
+    }
+    if (y1 > y2) {
+        std::swap(y2, y1);
+        std::swap(x2, x1);
+    }
+    if (y0 > y1) {
+        std::swap(y0, y1);
+        std::swap(x0, x1);
+    }
+    if (y0 == y2) { // All on the same line
+        a = b = x0;
+        if (x1 < a) a = x1;
+        else if (x1 > b) b = x1;
+        if (x2 < a) a = x2;
+        else if (x2 > b) b = x2;
+        drawFastHLine(a, y0, b - a + 1, color);
+        return;
+    }
+    const int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+    // Upper part: scanlines y0..y1 (y1 skipped unless the lower part is flat)
+    last = (y1 == y2) ? y1 : y1 - 1;
+    for (y = y0; y <= last; y++) {
+        a = x0 + sa / dy01;
+        b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        if (a > b) std::swap(a, b);
+        drawFastHLine(a, y, b - a + 1, color);
+    }
+    // Lower part: scanlines y1..y2
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++) {
+        a = x1 + sa / dy12;
+        b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        if (a > b) std::swap(a, b);
+        drawFastHLine(a, y, b - a + 1, color);
+    }
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {
+    const int16_t byteWidth = (w + 7) / 8;
+    uint8_t b = 0;
+    for (int16_t j = 0; j < h; j++, y++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (i & 7) b <<= 1;
+            else b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+            if (b & 0x80) drawPixel(x + i, y, color);
+        }
+    }
+}
+
+// ---- Text (GFXfont only) ----
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color) {
+    c -= (uint8_t)pgm_read_word(&gfxFont->first);
+    const GFXglyph* glyph = gfxFont->glyph + c;
+    const uint8_t* bitmap = gfxFont->bitmap;
+    uint16_t bo = glyph->bitmapOffset;
+    const uint8_t w = glyph->width, h = glyph->height;
+    const int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+    uint8_t bits = 0, bit = 0;
+    for (uint8_t yy = 0; yy < h; yy++) {
+        for (uint8_t xx = 0; xx < w; xx++) {
+            if (!(bit++ & 7)) bits = pgm_read_byte(&bitmap[bo++]);
+            if (bits & 0x80) drawPixel(x + xo + xx, y + yo + yy, color);
+            bits <<= 1;
+        }
+    }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (!gfxFont) return 1;
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += gfxFont->yAdvance;
+    } else if (c != '\r') {
+        const uint8_t first = gfxFont->first;
+        if (c >= first && c <= (uint8_t)gfxFont->last) {
+            const GFXglyph* glyph = gfxFont->glyph + (c - first);
+            const uint8_t w = glyph->width, h = glyph->height;
+            if (w > 0 && h > 0) {
+                const int16_t xo = glyph->xOffset;
+                if (wrap && cursor_x + (xo + w) > _width) {
+                    cursor_x = 0;
+                    cursor_y += gfxFont->yAdvance;
+                }
+                drawChar(cursor_x, cursor_y, c, textcolor);
+            }
+            cursor_x += glyph->xAdvance;
+        }
+    }
+    return 1;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t* x, int16_t* y, int16_t* minx, int16_t* miny, int16_t* maxx, int16_t* maxy) {
+    if (c == '\n') {
+        *x = 0;
+        *y += gfxFont->yAdvance;
+    } else if (c != '\r') {
+        const uint8_t first = gfxFont->first, last = gfxFont->last;
+        if (c >= first && c <= last) {
+            const GFXglyph* glyph = gfxFont->glyph + (c - first);
+            const uint8_t gw = glyph->width, gh = glyph->height, xa = glyph->xAdvance;
+            const int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+            if (wrap && (*x + (xo + gw)) > _width) {
+                *x = 0;
+                *y += gfxFont->yAdvance;
+            }
+            const int16_t x1 = *x + xo, y1 = *y + yo, x2 = x1 + gw - 1, y2 = y1 + gh - 1;
+            if (x1 < *minx) *minx = x1;
+            if (y1 < *miny) *miny = y1;
+            if (x2 > *maxx) *maxx = x2;
+            if (y2 > *maxy) *maxy = y2;
+            *x += xa;
+        }
+    }
+}
+
+void Adafruit_GFX::getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+    int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+    *x1 = x;
+    *y1 = y;
+    *w = *h = 0;
+    if (!gfxFont) return;
+    uint8_t c;
+    while ((c = *str++)) charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+    if (maxx >= minx) {
+        *x1 = minx;
+        *w = maxx - minx + 1;
+    }
+    if (maxy >= miny) {
+        *y1 = miny;
+        *h = maxy - miny + 1;
+    }
+}
@@ -0,0 +1,46 @@
+// Arduino.h - Host stand-in for the Arduino core: the subset of String, Print, Serial and timing the
+// headers under test use. Not a general Arduino emulation.
+
+#pragma once
+
+#include <algorithm>
+#include <ctype.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pgmspace.h"
+#include "WString.h"
+
+using std::max;
+using std::min;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+class Print {
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+
+    size_t print(const char* s) {
+        size_t n = 0;
+        while (*s) n += write((uint8_t)*s++);
+        return n;
+    }
+    size_t print(const String& s) { return print(s.c_str()); }
+};
+
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    int printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+    void print(const char* s) { fputs(s, stderr); }
+    void print(const String& s) { print(s.c_str()); }
+    void println(const char* s = "") { fprintf(stderr, "%s\n", s); }
+    void println(const String& s) { println(s.c_str()); }
+};
+extern HostSerial Serial;
@@ -0,0 +1,7 @@
+// FreeSans12pt7b.h - Host stand-in font (see mock_font.h).
+
+#pragma once
+
+#include <mock_font.h>
+
+static const GFXfont FreeSans12pt7b = hostMockFont(12, false);
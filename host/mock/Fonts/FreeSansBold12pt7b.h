@@ -0,0 +1,7 @@
+// FreeSansBold12pt7b.h - Host stand-in font (see mock_font.h).
+
+#pragma once
+
+#include <mock_font.h>
+
+static const GFXfont FreeSansBold12pt7b = hostMockFont(12, true);
@@ -0,0 +1,7 @@
+// FreeSansBold18pt7b.h - Host stand-in font (see mock_font.h).
+
+#pragma once
+
+#include <mock_font.h>
+
+static const GFXfont FreeSansBold18pt7b = hostMockFont(18, true);
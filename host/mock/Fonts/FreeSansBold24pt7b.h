@@ -0,0 +1,7 @@
+// FreeSansBold24pt7b.h - Host stand-in font (see mock_font.h).
+
+#pragma once
+
+#include <mock_font.h>
+
+static const GFXfont FreeSansBold24pt7b = hostMockFont(24, true);
@@ -0,0 +1,8 @@
+// GxEPD2.h - Colour values shared by the GxEPD2 drivers (host stand-in).
+
+#pragma once
+
+#define GxEPD_BLACK 0x0000
+#define GxEPD_WHITE 0xFFFF
+#define GxEPD_RED 0xF800
+#define GxEPD_YELLOW 0xFFE0
@@ -0,0 +1,151 @@
+// GxEPD2_3C.h - Host stand-in for GxEPD2's three-colour template and the 7.5" 880x528 panel.
+//
+// GxEPD2_3C pages exactly like the library: drawPixel() writes into page_height-line black and
+// colour buffers (active-low) and nextPage() pushes each band with writeImage(). The panel keeps
+// the two full planes it was sent, counts refreshes, and writes them out as PBM images.
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <GxEPD2.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+
+class GxEPD2_750c_Z90 {
+public:
+    static const uint16_t WIDTH = 880;
+    static const uint16_t HEIGHT = 528;
+    static const size_t PLANE_BYTES = (size_t)(WIDTH / 8) * HEIGHT;
+
+    GxEPD2_750c_Z90(int16_t cs, int16_t dc, int16_t rst, int16_t busy)
+        : black_(PLANE_BYTES, 0xFF), color_(PLANE_BYTES, 0xFF) {
+        (void)cs, (void)dc, (void)rst, (void)busy;
+    }
+
+    void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h) {
+        // Only whole-width, byte-aligned writes occur (full-window pages and full frames).
+        const size_t stride = WIDTH / 8, row = (size_t)w / 8;
+        for (int16_t r = 0; r < h; r++) {
+            const size_t dst = (size_t)(y + r) * stride + x / 8;
+            memcpy(&black_[dst], black + r * row, row);
+            memcpy(&color_[dst], color + r * row, row);
+        }
+        writes_++;
+    }
+    void refresh(bool partial = false) {
+        (void)partial;
+        refreshes_++;
+    }
+    void powerOff() {}
+    void hibernate() {}
+    void setBusyCallback(void (*cb)(const void*)) { (void)cb; }
+
+    // Planes as last sent (bit clear = black / red pixel), row-major, MSB = leftmost.
+    const std::vector<uint8_t>& blackPlane() const { return black_; }
+    const std::vector<uint8_t>& colorPlane() const { return color_; }
+    int refreshes() const { return refreshes_; }
+    int writes() const { return writes_; }
+
+    // Writes one plane as a binary PBM (P4, 1 = ink).
+    bool writePbm(const char* path, bool colorPlane) const {
+        FILE* f = fopen(path, "wb");
+        if (!f) return false;
+        fprintf(f, "P4\n%u %u\n", WIDTH, HEIGHT);
+        const std::vector<uint8_t>& p = colorPlane ? color_ : black_;
+        for (uint8_t b : p) fputc((uint8_t)~b, f);
+        return fclose(f) == 0;
+    }
+
+private:
+    std::vector<uint8_t> black_, color_;
+    int refreshes_ = 0;
+    int writes_ = 0;
+};
+
+template <typename GxEPD2_Type, const uint16_t page_height>
+class GxEPD2_3C : public Adafruit_GFX {
+public:
+    GxEPD2_Type epd2;
+
+    explicit GxEPD2_3C(GxEPD2_Type epd2_instance)
+        : Adafruit_GFX(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(std::move(epd2_instance)) {}
+
+    void init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration, bool pulldown_rst_mode) {
+        (void)serial_diag_bitrate, (void)initial, (void)reset_duration, (void)pulldown_rst_mode;
+    }
+
+    void fillScreen(uint16_t color) override {
+        const bool black = color == GxEPD_BLACK, red = color == GxEPD_RED || color == GxEPD_YELLOW;
+        memset(black_buffer_, black ? 0x00 : 0xFF, sizeof black_buffer_);
+        memset(color_buffer_, red ? 0x00 : 0xFF, sizeof color_buffer_);
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || x >= width() || y < 0 || y >= height()) return;
+        switch (getRotation()) {
+            case 1:
+                std::swap(x, y);
+                x = GxEPD2_Type::WIDTH - x - 1;
+                break;
+            case 2:
+                x = GxEPD2_Type::WIDTH - x - 1;
+                y = GxEPD2_Type::HEIGHT - y - 1;
+                break;
+            case 3:
+                std::swap(x, y);
+                y = GxEPD2_Type::HEIGHT - y - 1;
+                break;
+        }
+        y -= current_page_ * page_height;
+        if (y < 0 || y >= page_height) return;
+        const size_t i = x / 8 + (size_t)y * (GxEPD2_Type::WIDTH / 8);
+        const uint8_t bit = 1 << (7 - x % 8);
+        if (color == GxEPD_WHITE) {
+            black_buffer_[i] |= bit;
+            color_buffer_[i] |= bit;
+        } else if (color == GxEPD_BLACK) {
+            black_buffer_[i] &= ~bit;
+            color_buffer_[i] |= bit;
+        } else if (color == GxEPD_RED || color == GxEPD_YELLOW) {
+            black_buffer_[i] |= bit;
+            color_buffer_[i] &= ~bit;
+        } else if ((color & 0xF100) > (0xF100 / 2)) {
+            black_buffer_[i] |= bit;
+            color_buffer_[i] &= ~bit;
+        } else if ((((color & 0xF100) >> 11) + ((color & 0x07E0) >> 5) + (color & 0x001F)) < 3 * 255 / 2) {
+            black_buffer_[i] &= ~bit;
+            color_buffer_[i] |= bit;
+        } else {
+            black_buffer_[i] |= bit;
+            color_buffer_[i] |= bit;
+        }
+    }
+
+    void setFullWindow() {}
+    void firstPage() { current_page_ = 0; }
+
+    bool nextPage() {
+        const int16_t ys = current_page_ * page_height;
+        const int16_t rows = std::min<int16_t>(page_height, GxEPD2_Type::HEIGHT - ys);
+        epd2.writeImage(black_buffer_, color_buffer_, 0, ys, GxEPD2_Type::WIDTH, rows);
+        if (ys + rows >= GxEPD2_Type::HEIGHT) {
+            current_page_ = 0;
+            epd2.refresh(false);
+            epd2.powerOff();
+            return false;
+        }
+        current_page_++;
+        fillScreen(GxEPD_WHITE);
+        return true;
+    }
+
+    void hibernate() { epd2.hibernate(); }
+
+private:
+    uint8_t black_buffer_[(GxEPD2_Type::WIDTH / 8) * page_height];
+    uint8_t color_buffer_[(GxEPD2_Type::WIDTH / 8) * page_height];
+    int16_t current_page_ = 0;
+};
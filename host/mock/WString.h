@@ -0,0 +1,69 @@
+// WString.h - Host stand-in for Arduino's String: a NUL-terminated buffer on the heap. Every
+// non-empty String allocates (there is no small-string buffer), so host allocation counts are an
+// upper bound on the device's.
+
+#pragma once
+
+#include <stddef.h>
+
+class String {
+public:
+    String(const char* s = "");
+    String(const char* s, unsigned len);
+    String(const String& o);
+    String(String&& o) noexcept;
+    explicit String(char c);
+    explicit String(int v);
+    explicit String(unsigned v);
+    explicit String(long v);
+    explicit String(unsigned long v);
+    ~String();
+
+    String& operator=(const String& o);
+    String& operator=(String&& o) noexcept;
+    String& operator=(const char* s);
+
+    const char* c_str() const { return buf_ ? buf_ : ""; }
+    unsigned length() const { return len_; }
+    bool isEmpty() const { return len_ == 0; }
+    bool reserve(unsigned size);
+
+    bool concat(const char* s, unsigned len);
+    bool concat(const char* s);
+    bool concat(const String& s) { return concat(s.c_str(), s.len_); }
+    bool concat(char c) { return concat(&c, 1); }
+    String& operator+=(const String& s) { concat(s); return *this; }
+    String& operator+=(const char* s) { concat(s); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+    String& operator+=(int v) { concat(String(v)); return *this; }
+
+    bool operator==(const String& o) const;
+    bool operator==(const char* s) const;
+    bool operator!=(const String& o) const { return !(*this == o); }
+    bool operator!=(const char* s) const { return !(*this == s); }
+    char operator[](unsigned i) const { return i < len_ ? buf_[i] : 0; }
+    char& operator[](unsigned i);
+
+    int indexOf(char c, unsigned from = 0) const;
+    int indexOf(const char* s, unsigned from = 0) const;
+    int indexOf(const String& s, unsigned from = 0) const { return indexOf(s.c_str(), from); }
+    bool startsWith(const char* s) const;
+    bool endsWith(const char* s) const;
+    String substring(unsigned from, unsigned to = (unsigned)-1) const;
+    void replace(const String& find, const String& with);
+    void remove(unsigned index, unsigned count = (unsigned)-1);
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const;
+
+private:
+    char* buf_ = nullptr;
+    unsigned len_ = 0;
+    unsigned cap_ = 0;
+};
+
+String operator+(const String& a, const String& b);
+String operator+(const String& a, const char* b);
+String operator+(const char* a, const String& b);
+String operator+(const String& a, char b);
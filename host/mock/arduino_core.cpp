@@ -0,0 +1,202 @@
+// arduino_core.cpp - Host implementations behind Arduino.h and WString.h.
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <ctype.h>
+#include <stdarg.h>
+#include <thread>
+
+HostSerial Serial;
+
+static const auto host_start = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - host_start).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - host_start).count();
+}
+
+void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+int HostSerial::printf(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    const int n = vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+// -------------------- String --------------------
+String::String(const char* s) { concat(s); }
+String::String(const char* s, unsigned len) { concat(s, len); }
+String::String(const String& o) { concat(o); }
+String::String(String&& o) noexcept : buf_(o.buf_), len_(o.len_), cap_(o.cap_) {
+    o.buf_ = nullptr;
+    o.len_ = o.cap_ = 0;
+}
+String::String(char c) { concat(c); }
+
+static String fromFormat(const char* fmt, long long v) {
+    char b[24];
+    snprintf(b, sizeof b, fmt, v);
+    return String(b);
+}
+
+String::String(int v) : String(fromFormat("%lld", v)) {}
+String::String(unsigned v) : String(fromFormat("%lld", v)) {}
+String::String(long v) : String(fromFormat("%lld", v)) {}
+String::String(unsigned long v) : String(fromFormat("%lld", (long long)v)) {}
+String::~String() { free(buf_); }
+
+String& String::operator=(const String& o) {
+    if (this != &o) {
+        len_ = 0;
+        concat(o);
+    }
+    return *this;
+}
+
+String& String::operator=(String&& o) noexcept {
+    if (this != &o) {
+        free(buf_);
+        buf_ = o.buf_;
+        len_ = o.len_;
+        cap_ = o.cap_;
+        o.buf_ = nullptr;
+        o.len_ = o.cap_ = 0;
+    }
+    return *this;
+}
+
+String& String::operator=(const char* s) {
+    len_ = 0;
+    if (buf_) buf_[0] = '\0';
+    concat(s);
+    return *this;
+}
+
+bool String::reserve(unsigned size) {
+    if (buf_ && cap_ >= size) return true;
+    char* b = (char*)realloc(buf_, size + 1);
+    if (!b) return false;
+    if (!buf_) b[0] = '\0';
+    buf_ = b;
+    cap_ = size;
+    return true;
+}
+
+bool String::concat(const char* s, unsigned len) {
+    if (!s) return false;
+    if (!len) return true;
+    if (!reserve(len_ + len)) return false;
+    memmove(buf_ + len_, s, len);
+    len_ += len;
+    buf_[len_] = '\0';
+    return true;
+}
+
+bool String::concat(const char* s) { return s && concat(s, (unsigned)strlen(s)); }
+
+bool String::operator==(const String& o) const { return len_ == o.len_ && strcmp(c_str(), o.c_str()) == 0; }
+bool String::operator==(const char* s) const { return strcmp(c_str(), s ? s : "") == 0; }
+
+char& String::operator[](unsigned i) {
+    static char dummy;
+    return i < len_ ? buf_[i] : (dummy = 0);
+}
+
+int String::indexOf(char c, unsigned from) const {
+    if (from >= len_) return -1;
+    const char* p = strchr(buf_ + from, c);
+    return p ? (int)(p - buf_) : -1;
+}
+
+int String::indexOf(const char* s, unsigned from) const {
+    if (from > len_) return -1;
+    const char* p = strstr(c_str() + from, s);
+    return p ? (int)(p - c_str()) : -1;
+}
+
+bool String::startsWith(const char* s) const { return strncmp(c_str(), s, strlen(s)) == 0; }
+
+bool String::endsWith(const char* s) const {
+    const size_t n = strlen(s);
+    return n <= len_ && strcmp(c_str() + len_ - n, s) == 0;
+}
+
+String String::substring(unsigned from, unsigned to) const {
+    if (from > to) std::swap(from, to);
+    if (to > len_) to = len_;
+    if (from >= to) return String();
+    return String(buf_ + from, to - from);
+}
+
+void String::replace(const String& find, const String& with) {
+    if (!len_ || !find.len_) return;
+    String out;
+    const char* p = buf_;
+    while (const char* hit = strstr(p, find.c_str())) {
+        out.concat(p, (unsigned)(hit - p));
+        out.concat(with);
+        p = hit + find.len_;
+    }
+    if (p == buf_) return;
+    out.concat(p);
+    *this = static_cast<String&&>(out);
+}
+
+void String::remove(unsigned index, unsigned count) {
+    if (index >= len_) return;
+    if (count > len_ - index) count = len_ - index;
+    memmove(buf_ + index, buf_ + index + count, len_ - index - count + 1);
+    len_ -= count;
+}
+
+void String::trim() {
+    if (!len_) return;
+    unsigned a = 0, b = len_;
+    while (a < b && isspace((unsigned char)buf_[a])) a++;
+    while (b > a && isspace((unsigned char)buf_[b - 1])) b--;
+    memmove(buf_, buf_ + a, b - a);
+    len_ = b - a;
+    buf_[len_] = '\0';
+}
+
+void String::toLowerCase() {
+    for (unsigned i = 0; i < len_; i++) buf_[i] = (char)tolower((unsigned char)buf_[i]);
+}
+
+void String::toUpperCase() {
+    for (unsigned i = 0; i < len_; i++) buf_[i] = (char)toupper((unsigned char)buf_[i]);
+}
+
+long String::toInt() const { return atol(c_str()); }
+
+String operator+(const String& a, const String& b) {
+    String s(a);
+    s.concat(b);
+    return s;
+}
+
+String operator+(const String& a, const char* b) {
+    String s(a);
+    s.concat(b);
+    return s;
+}
+
+String operator+(const char* a, const String& b) {
+    String s(a);
+    s.concat(b);
+    return s;
+}
+
+String operator+(const String& a, char b) {
+    String s(a);
+    s.concat(b);
+    return s;
+}
@@ -0,0 +1,8 @@
+// esp32-hal-psram.h - Host stand-in: the host always "has PSRAM", backed by the normal heap.
+
+#pragma once
+
+#include <stdlib.h>
+
+static inline bool psramFound() { return true; }
+static inline void* ps_malloc(size_t size) { return malloc(size); }
@@ -0,0 +1,13 @@
+// mock_font.h - Deterministic stand-ins for the Adafruit FreeSans GFXfonts, which are not vendored.
+//
+// Each font scales the classic 5x7 glyph set to the FreeSans cap height for its point size, trimmed
+// to each glyph's inked columns so advances stay proportional; bold adds stroke width. Shapes and
+// metrics differ from the real fonts, so golden frames check layout (placement, clipping, fitting,
+// paging), not typography.
+
+#pragma once
+
+#include <gfxfont.h>
+
+// Built on first call and kept for the process lifetime.
+GFXfont hostMockFont(int points, bool bold);
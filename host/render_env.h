@@ -0,0 +1,49 @@
+// render_env.h - What render.h expects from its includer (see its header comment), for host builds:
+// the mock panel, no-op metric timers, an in-memory frame fingerprint and a fixed clock.
+
+#pragma once
+
+#include <Arduino.h>
+#include <GxEPD2_3C.h>
+
+#include "full_frame_display.h"
+#include "parkpal_types.h"
+#include "tz_rule.h"
+
+#define PARKPAL_DEBUG 0
+#define DBG_PRINTF(...) do { if (PARKPAL_DEBUG) Serial.printf(__VA_ARGS__); } while (0)
+
+using Panel = GxEPD2_750c_Z90;
+const uint16_t PAGE_H = 64;
+FullFrameDisplay<Panel, PAGE_H> display(Panel(0, 0, 0, 0));
+
+class StageTimer {
+public:
+    explicit StageTimer(MetricStage) {}
+    void stop() {}
+};
+
+class DrawTimer {
+public:
+    ~DrawTimer() {}
+};
+
+static uint64_t panel_frame_hash = 0;
+
+static bool frameOnPanel(uint64_t hash) { return hash && hash == panel_frame_hash; }
+static void frameShown(uint64_t hash) { panel_frame_hash = hash; }
+static void forgetFrame() { panel_frame_hash = 0; }
+
+// Trip countdowns count from a fixed instant so frames don't depend on when the tests run.
+static const time_t HOST_NOW = 1767268800; // 2026-01-01 12:00 UTC
+
+bool daysToDateInTz(const char* isoDate, const char* tz, int& outDays) {
+    TzRule rule;
+    tzRuleParse(tz, rule);
+    int ty, tm, td, y, m, d;
+    tzLocalDate(rule, HOST_NOW, ty, tm, td);
+    if (sscanf(isoDate, "%4d-%2d-%2d", &y, &m, &d) != 3) return false;
+    const int32_t diff = tzDaysFromCivil(y, (unsigned)m, (unsigned)d) - tzDaysFromCivil(ty, (unsigned)tm, (unsigned)td);
+    outDays = diff < 0 ? 0 : (int)diff;
+    return true;
+}
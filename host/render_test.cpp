@@ -0,0 +1,96 @@
+// render_test.cpp - Golden-frame tests for render.h.
+//
+// Renders every scene (scenes.h) paged and full-frame, checks both modes send the panel identical
+// planes, and compares them with host/golden/<scene>.{black,red}.pbm. Mismatching frames are written
+// to the working directory for inspection. Set PARKPAL_UPDATE_GOLDEN=1 to rewrite the goldens
+// after an intended layout change.
+
+#include "render_env.h"
+
+#include "render.h"
+
+#include "scenes.h"
+
+#include <string>
+#include <vector>
+
+#ifndef PARKPAL_GOLDEN_DIR
+#define PARKPAL_GOLDEN_DIR "golden"
+#endif
+
+struct Planes {
+    std::vector<uint8_t> black, red;
+};
+
+static Planes renderScene(const Scene& scene, bool fullFrame) {
+    if (fullFrame) display.enableFullFrame();
+    else display.disableFullFrame();
+    forgetFrame();
+    scene.draw();
+    return { display.epd2.blackPlane(), display.epd2.colorPlane() };
+}
+
+static bool readPbm(const std::string& path, std::vector<uint8_t>& out) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    unsigned w = 0, h = 0;
+    const bool ok = fscanf(f, "P4 %u %u", &w, &h) == 2 && fgetc(f) != EOF && w == Panel::WIDTH && h == Panel::HEIGHT;
+    out.assign(Panel::PLANE_BYTES, 0);
+    const bool read = ok && fread(out.data(), 1, out.size(), f) == out.size();
+    fclose(f);
+    for (uint8_t& b : out) b = (uint8_t)~b; // PBM 1 = ink; planes are active-low
+    return read;
+}
+
+static size_t diffPixels(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    size_t n = 0;
+    for (size_t i = 0; i < a.size(); i++) n += __builtin_popcount((uint8_t)(a[i] ^ b[i]));
+    return n;
+}
+
+static int failures = 0;
+
+static void fail(const char* scene, const char* what) {
+    printf("FAIL %s: %s\n", scene, what);
+    failures++;
+}
+
+int main() {
+    const bool update = getenv("PARKPAL_UPDATE_GOLDEN") && *getenv("PARKPAL_UPDATE_GOLDEN") == '1';
+    display.setRotation(4); // As in setup()
+    for (const Scene& scene : SCENES) {
+        const Planes paged = renderScene(scene, false);
+        if (frame.dropped()) fail(scene.name, "display list overflowed");
+        const Planes full = renderScene(scene, true);
+        if (paged.black != full.black || paged.red != full.red) fail(scene.name, "paged and full-frame planes differ");
+
+        // A second identical render must not refresh the panel.
+        const int refreshes = display.epd2.refreshes();
+        scene.draw();
+        if (display.epd2.refreshes() != refreshes) fail(scene.name, "unchanged frame was pushed again");
+
+        const std::string base = std::string(PARKPAL_GOLDEN_DIR) + "/" + scene.name;
+        if (update) {
+            display.epd2.writePbm((base + ".black.pbm").c_str(), false);
+            display.epd2.writePbm((base + ".red.pbm").c_str(), true);
+            printf("updated %s\n", scene.name);
+            continue;
+        }
+        std::vector<uint8_t> black, red;
+        if (!readPbm(base + ".black.pbm", black) || !readPbm(base + ".red.pbm", red)) {
+            fail(scene.name, "missing golden (run with PARKPAL_UPDATE_GOLDEN=1)");
+            continue;
+        }
+        const size_t dBlack = diffPixels(black, full.black), dRed = diffPixels(red, full.red);
+        if (dBlack || dRed) {
+            printf("FAIL %s: %zu black and %zu red pixels differ from the golden; wrote %s.{black,red}.pbm\n",
+                   scene.name, dBlack, dRed, scene.name);
+            display.epd2.writePbm((std::string(scene.name) + ".black.pbm").c_str(), false);
+            display.epd2.writePbm((std::string(scene.name) + ".red.pbm").c_str(), true);
+            failures++;
+        } else {
+            printf("ok %s\n", scene.name);
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,133 @@
+// scenes.h - The frames the host tests render: one per screen and layout branch, with fixed inputs.
+// Include after render.h.
+
+#pragma once
+
+static const char* const SCENE_TZ = "EST5EDT,M3.2.0/2,M11.1.0/2";
+
+static void addRide(ParkSummary& s, int32_t id, int16_t wait, bool open, const char* name) {
+    RideStatus& r = s.rides[s.rides_n++];
+    r.id = id;
+    r.wait = wait;
+    r.open = open;
+    strncpy(r.name, name, SUMMARY_NAME_MAX);
+}
+
+static ParkSummary sceneSummary(bool metric, int16_t temp, uint16_t code, const char* desc) {
+    ParkSummary s;
+    s.metric = metric;
+    s.temp = temp;
+    s.code = code;
+    strncpy(s.desc, desc, SUMMARY_DESC_MAX);
+    return s;
+}
+
+// Rides by id, one matched by name, a closed one, one clipped to the column and one the summary
+// doesn't list.
+static void sceneParks() {
+    static ParkSummary s = [] {
+        ParkSummary p = sceneSummary(true, 27, 800, "clear sky");
+        addRide(p, 101, 35, true, "Seven Dwarfs Mine Train");
+        addRide(p, 102, 0, false, "Space Mountain");
+        addRide(p, 103, 120, true, "TRON Lightcycle / Run - with a name far too long for the ride column");
+        addRide(p, 104, 10, true, "Peter Pan’s Flight");
+        return p;
+    }();
+    static const int ids[6] = { 101, 102, 103, 0, 0, 999 };
+    static const RideLabel labels[6] = { "", "", "", "Peter Pan's Flight", "", "Haunted Mansion" };
+    static const RideLabel legacy[6];
+    static const char *const park = "Magic Kingdom", *const trip = "2026-03-15", *const name = "Spring Break";
+    renderParks(s, ids, labels, park, true, true, trip, name, legacy, SCENE_TZ);
+}
+
+// Fahrenheit, weather icon from the description, legacy ride names, no trip.
+static void sceneParksImperial() {
+    static ParkSummary s = [] {
+        ParkSummary p = sceneSummary(false, 81, 0, "light rain");
+        addRide(p, 201, 55, true, "Avatar Flight of Passage");
+        addRide(p, 202, 0, false, "Kilimanjaro Safaris");
+        return p;
+    }();
+    static const int ids[6] = {};
+    static const RideLabel labels[6];
+    static const RideLabel legacy[6] = { "Avatar Flight of Passage", "Kilimanjaro Safaris" };
+    static const char *const park = "Animal Kingdom", *const trip = "", *const name = "";
+    renderParks(s, ids, labels, park, false, false, trip, name, legacy, SCENE_TZ);
+}
+
+static void sceneParksGetStarted() {
+    static const ParkSummary s = sceneSummary(true, 18, 804, "overcast clouds");
+    static const int ids[6] = {};
+    static const RideLabel labels[6], legacy[6];
+    static const char *const park = "EPCOT", *const trip = "", *const name = "";
+    renderParks(s, ids, labels, park, true, false, trip, name, legacy, SCENE_TZ);
+}
+
+// Trip on but its date unset: "TRIP COUNTDOWN" and the red dash, no rides yet.
+static void sceneParksNoRides() {
+    static const ParkSummary s = sceneSummary(true, 31, 211, "thunderstorm");
+    static const int ids[6] = {};
+    static const RideLabel labels[6], legacy[6];
+    static const char *const park = "Hollywood Studios", *const trip = "", *const name = "";
+    renderParks(s, ids, labels, park, true, true, trip, name, legacy, SCENE_TZ);
+}
+
+static CountdownItem sceneCountdown(const char* id, const char* l0, const char* l1, int month, int day) {
+    CountdownItem c;
+    c.id = id;
+    c.label[0] = l0;
+    c.label[1] = l1;
+    c.month = month;
+    c.day = day;
+    return c;
+}
+
+static void sceneCountdownTree() {
+    static const CountdownItem c = sceneCountdown("xmas", "Christmas", "", 12, 25);
+    renderCountdowns(c, 42, 0);
+}
+
+static void sceneCountdownBirthday() {
+    static const CountdownItem c = [] {
+        CountdownItem i = sceneCountdown("bday", "Maya's", "Birthday", 1, 1);
+        i.birth_year = 2019;
+        return i;
+    }();
+    renderCountdowns(c, 0, 7);
+}
+
+// Four label lines push the icon to the top-right; three days left turns the number red.
+static void sceneCountdownFull() {
+    static const CountdownItem c = [] {
+        CountdownItem i = sceneCountdown("trip", "Family Trip", "Walt Disney World", 3, 15);
+        i.label[2] = "Fly out of Boston Logan International";
+        i.label[3] = "Pack the ponchos";
+        i.icon = "ghost";
+        return i;
+    }();
+    renderCountdowns(c, 3, 0);
+}
+
+static void sceneMessage() { renderMessage("Syncing Time...", MSG_FONT); }
+static void sceneGetStarted() { renderGetStarted(); }
+static void sceneSetup() { renderSetupScreen("ParkPal-3F2A", "parkpal1234"); }
+static void sceneBoot() { renderBootScreen(true, "192.168.1.42"); }
+
+struct Scene {
+    const char* name;
+    void (*draw)();
+};
+
+static const Scene SCENES[] = {
+    { "parks", sceneParks },
+    { "parks_imperial", sceneParksImperial },
+    { "parks_get_started", sceneParksGetStarted },
+    { "parks_no_rides", sceneParksNoRides },
+    { "countdown_tree", sceneCountdownTree },
+    { "countdown_birthday", sceneCountdownBirthday },
+    { "countdown_full", sceneCountdownFull },
+    { "message", sceneMessage },
+    { "get_started", sceneGetStarted },
+    { "setup", sceneSetup },
+    { "boot", sceneBoot },
+};
@@ -0,0 +1,94 @@
+// summary_decode.cpp - Decodes binary summaries with summary_codec.h and prints them as JSON, for
+// summary_roundtrip.mjs.
+//
+// stdin is a sequence of inputs, each a kind byte ('r' = one PPS record, 'b' = a PPB batch), a
+// uint32 little-endian length and that many bytes. stdout gets one JSON line per input:
+// {"ok":false} when decoding fails, else the decoded fields. A batch is walked the way
+// readSummaryBatchBin() in parkpal.ino reads it off the stream.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+#include "summary_codec.h"
+
+static void printString(const char* s) {
+    putchar('"');
+    for (const unsigned char* p = (const unsigned char*)s; *p; p++) {
+        if (*p == '"' || *p == '\\') printf("\\%c", *p);
+        else if (*p < 0x20) printf("\\u%04x", *p);
+        else putchar(*p);
+    }
+    putchar('"');
+}
+
+static void printSummary(const ParkSummary& s) {
+    printf("{\"metric\":%s,\"temp\":%d,\"code\":%u,\"sunrise\":%u,\"sunset\":%u,\"updated_at\":%u,",
+           s.metric ? "true" : "false", s.temp, s.code, s.sunrise, s.sunset, s.updated_at);
+    printf("\"opens\":%u,\"closes\":%u,\"operating\":%s,\"volatility\":%u,\"desc\":", s.opens, s.closes,
+           s.operating ? "true" : "false", s.volatility);
+    printString(s.desc);
+    printf(",\"rides\":[");
+    for (int i = 0; i < s.rides_n; i++) {
+        const RideStatus& r = s.rides[i];
+        printf("%s{\"id\":%d,\"wait\":%d,\"open\":%s,\"name\":", i ? "," : "", r.id, r.wait, r.open ? "true" : "false");
+        printString(r.name);
+        putchar('}');
+    }
+    printf("]}");
+}
+
+static void decodeRecord(const std::vector<uint8_t>& in) {
+    ParkSummary s;
+    if (!decodeSummaryBin(in.data(), in.size(), s)) {
+        printf("{\"ok\":false}\n");
+        return;
+    }
+    printf("{\"ok\":true,\"summary\":");
+    printSummary(s);
+    printf("}\n");
+}
+
+static void decodeBatch(const std::vector<uint8_t>& in) {
+    static ParkSummary parks[256];
+    uint32_t ids[256];
+    uint8_t count = 0;
+    size_t pos = 0;
+    bool ok = in.size() >= SUMMARY_BATCH_HEADER && decodeSummaryBatchHeader(in.data(), count);
+    pos = SUMMARY_BATCH_HEADER;
+    for (int i = 0; ok && i < count; i++) {
+        uint16_t len = 0;
+        ok = pos + SUMMARY_BATCH_ENTRY_HEADER <= in.size();
+        if (!ok) break;
+        decodeSummaryBatchEntryHeader(in.data() + pos, ids[i], len);
+        pos += SUMMARY_BATCH_ENTRY_HEADER;
+        parks[i] = ParkSummary();
+        ok = len <= SUMMARY_BIN_MAX && pos + len <= in.size() && decodeSummaryBin(in.data() + pos, len, parks[i]);
+        pos += len;
+    }
+    if (!ok) {
+        printf("{\"ok\":false}\n");
+        return;
+    }
+    printf("{\"ok\":true,\"version\":%u,\"trailing\":%zu,\"parks\":[", in[3], in.size() - pos);
+    for (int i = 0; i < count; i++) {
+        printf("%s{\"id\":%u,\"summary\":", i ? "," : "", ids[i]);
+        printSummary(parks[i]);
+        putchar('}');
+    }
+    printf("]}\n");
+}
+
+int main() {
+    int kind;
+    while ((kind = getchar()) != EOF) {
+        uint8_t n[4];
+        if (fread(n, 1, 4, stdin) != 4) return 2;
+        std::vector<uint8_t> in(summaryRd32(n));
+        if (fread(in.data(), 1, in.size(), stdin) != in.size()) return 2;
+        if (kind == 'r') decodeRecord(in);
+        else if (kind == 'b') decodeBatch(in);
+        else return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+// summary_roundtrip.mjs - Encodes summaries with the Worker's encoder (summary_codec.js) and checks
+// that the firmware's decoder (summary_codec.h, via the summary_decode binary) reads back exactly
+// what was meant: v1 and v2 records, batches, clipping, and rejection of truncated, oversized and
+// malformed input.
+//
+//   node host/summary_roundtrip.mjs <path to summary_decode>
+
+import assert from "node:assert/strict";
+import { spawnSync } from "node:child_process";
+import { encodeSummaryBin, encodeSummaryBatchBin, SUMMARY_DESC_MAX, SUMMARY_NAME_MAX } from "../summary_codec.js";
+
+const decoder = process.argv[2];
+if (!decoder) {
+  console.error("usage: node summary_roundtrip.mjs <summary_decode>");
+  process.exit(2);
+}
+
+// --- Inputs ---
+
+const longName = "A".repeat(SUMMARY_NAME_MAX - 1) + "é"; // The 2-byte é would straddle the limit
+const rides = [
+  { id: 101, name: "Seven Dwarfs Mine Train", wait_time: 35, is_open: true },
+  { id: 102, name: "Space Mountain", wait_time: 0, is_open: false },
+  { id: 103, name: longName, wait_time: 120, is_open: true },
+  { id: 104, name: "Peter Pan’s Flight \"classic\" \\ 🧚", wait_time: null, is_open: true },
+  { id: 105, wait_time: -1, is_open: false }, // No name
+  { id: 4000000000, name: "Big Thunder Mountain Railroad", wait_time: 40000, is_open: true },
+  { id: 107, name: "Not sent: seventh ride", wait_time: 5, is_open: true },
+];
+const weather = { temp: -4.6, code: 800, desc: "clear sky, with a description well past forty-seven bytes ☀", sunrise: 1767267600, sunset: 1767305400 };
+const cadence = { hours: { opens: 540, closes: 1320 }, operating: true, volatility: 37 };
+const updatedAt = "2026-01-01T15:04:05.678Z";
+
+const records = {
+  v2: encodeSummaryBin("metric", updatedAt, rides, weather, cadence, 2),
+  v1: encodeSummaryBin("metric", updatedAt, rides, weather, cadence, 1),
+  v2Empty: encodeSummaryBin("imperial", null, [], null, null, 2),
+  v2Extremes: encodeSummaryBin("imperial", updatedAt, rides.slice(0, 1), { temp: 99999, code: 70000, desc: "" },
+    { hours: null, operating: false, volatility: 300 }, 2),
+  v2Default: encodeSummaryBin("metric", updatedAt, rides.slice(0, 2), weather, cadence), // Default version
+};
+
+// --- What the decoder must produce, derived from the inputs rather than the encoder ---
+
+function utf8Prefix(s, max) {
+  let out = "";
+  for (const ch of String(s)) {
+    if (Buffer.byteLength(out + ch) > max) break;
+    out += ch;
+  }
+  return out;
+}
+
+const i16 = (v) => Math.max(-32768, Math.min(32767, Math.round(Number(v) || 0)));
+
+function expected(units, at, rideList, w, c, version) {
+  return {
+    metric: units === "metric",
+    temp: i16(w?.temp),
+    code: Math.max(0, Math.min(0xffff, Number(w?.code) || 0)),
+    sunrise: w?.sunrise || 0,
+    sunset: w?.sunset || 0,
+    updated_at: at ? Math.floor(Date.parse(at) / 1000) : 0,
+    opens: version >= 2 && c?.hours ? c.hours.opens : 0xffff,
+    closes: version >= 2 && c?.hours ? c.hours.closes : 0xffff,
+    operating: version >= 2 && !!c?.operating,
+    volatility: version >= 2 && c?.volatility != null ? Math.min(254, c.volatility) : 0xff,
+    desc: utf8Prefix(w?.desc || "", SUMMARY_DESC_MAX),
+    rides: rideList.slice(0, 6).map(r => ({
+      id: r.id | 0, // int32 on the device
+      wait: i16(r.wait_time),
+      open: !!r.is_open,
+      name: utf8Prefix(r.name || "Unknown Ride", SUMMARY_NAME_MAX),
+    })),
+  };
+}
+
+// --- Decoding through the C++ side ---
+
+const inputs = [];
+const checks = [];
+
+function decode(kind, bytes, check) {
+  inputs.push({ kind, bytes });
+  checks.push(check);
+}
+
+function mutate(bytes, fn) {
+  const b = Uint8Array.from(bytes);
+  fn(b);
+  return b;
+}
+
+function insertAt(bytes, pos, extra) {
+  const b = new Uint8Array(bytes.length + extra.length);
+  b.set(bytes.subarray(0, pos), 0);
+  b.set(extra, pos);
+  b.set(bytes.subarray(pos), pos + extra.length);
+  return b;
+}
+
+const rejected = (what) => (out) => assert.deepEqual(out, { ok: false }, what);
+
+decode("r", records.v2, out => assert.deepEqual(out.summary, expected("metric", updatedAt, rides, weather, cadence, 2), "v2 record"));
+decode("r", records.v1, out => assert.deepEqual(out.summary, expected("metric", updatedAt, rides, weather, cadence, 1), "v1 record"));
+decode("r", records.v2Empty, out => assert.deepEqual(out.summary, expected("imperial", null, [], null, null, 2), "empty record"));
+decode("r", records.v2Extremes, out => assert.deepEqual(out.summary,
+  expected("imperial", updatedAt, rides.slice(0, 1), { temp: 99999, code: 70000, desc: "" }, { hours: null, volatility: 300 }, 2),
+  "clamped record"));
+decode("r", records.v2Default, out => assert.deepEqual(out.summary, expected("metric", updatedAt, rides.slice(0, 2), weather, cadence, 2),
+  "default version"));
+
+for (const [name, rec] of Object.entries(records)) {
+  for (let n = 0; n < rec.length; n++) decode("r", rec.subarray(0, n), rejected(`${name} truncated to ${n} bytes`));
+  decode("r", insertAt(rec, rec.length, [0]), rejected(`${name} with a trailing byte`));
+}
+
+const v2 = records.v2;
+const descAt = 28;
+decode("r", mutate(v2, b => { b[2] = 0x42; }), rejected("bad magic"));
+decode("r", mutate(v2, b => { b[3] = 3; }), rejected("unknown version"));
+decode("r", mutate(v2, b => { b[3] = 0; }), rejected("version 0"));
+decode("r", mutate(v2, b => { b[5] = 7; }), rejected("more rides than SUMMARY_MAX_RIDES"));
+assert.equal(v2[descAt], SUMMARY_DESC_MAX, "fixture desc fills SUMMARY_DESC_MAX");
+decode("r", insertAt(mutate(v2, b => { b[descAt] = SUMMARY_DESC_MAX + 1; }), descAt + 1, [0x41]), rejected("desc longer than SUMMARY_DESC_MAX"));
+const name0 = descAt + 1 + SUMMARY_DESC_MAX + 7; // First ride's name length byte
+decode("r", insertAt(mutate(v2, b => { b[name0] = 200; }), name0 + 1, new Array(200).fill(0x41)), rejected("name longer than SUMMARY_NAME_MAX"));
+
+// --- Batches ---
+
+const parks = [
+  { id: 6, updated_at: updatedAt, rides, weather, cadence },
+  { id: 7, updated_at: updatedAt, rides: [], weather: null, cadence: { hours: { opens: 480, closes: 0 }, operating: false, volatility: null } },
+  { id: 275, updated_at: null, rides: rides.slice(2, 4), weather, cadence: null },
+];
+const batchExpected = (version, list) => list.map(p => ({
+  id: p.id,
+  summary: expected("imperial", p.updated_at, p.rides, p.weather, p.cadence, version),
+}));
+const batches = {
+  v2: encodeSummaryBatchBin("imperial", parks, 2),
+  v1: encodeSummaryBatchBin("imperial", parks.slice(0, 2), 1),
+  empty: encodeSummaryBatchBin("imperial", [], 2),
+};
+
+decode("b", batches.v2, out => assert.deepEqual(out, { ok: true, version: 2, trailing: 0, parks: batchExpected(2, parks) }, "v2 batch"));
+decode("b", batches.v1, out => assert.deepEqual(out, { ok: true, version: 1, trailing: 0, parks: batchExpected(1, parks.slice(0, 2)) }, "v1 batch"));
+decode("b", batches.empty, out => assert.deepEqual(out, { ok: true, version: 2, trailing: 0, parks: [] }, "empty batch"));
+for (const [name, b] of Object.entries(batches)) {
+  for (let n = 0; n < b.length; n++) decode("b", b.subarray(0, n), rejected(`${name} batch truncated to ${n} bytes`));
+}
+// The device stops reading after the last record it was told about.
+decode("b", insertAt(batches.v2, batches.v2.length, [1, 2, 3]), out => assert.equal(out.trailing, 3, "batch trailing bytes"));
+decode("b", mutate(batches.v2, b => { b[2] = 0x53; }), rejected("batch bad magic"));
+decode("b", mutate(batches.v2, b => { b[3] = 3; }), rejected("batch unknown version"));
+decode("b", mutate(batches.v2, b => { b[4] = 4; }), rejected("batch with more parks than records"));
+decode("b", mutate(batches.v2, b => { b[9] = 0xff; b[10] = 0xff; }), rejected("batch record longer than SUMMARY_BIN_MAX"));
+decode("b", mutate(batches.v2, b => { b[9] -= 1; }), rejected("batch record length one short"));
+
+// --- Run ---
+
+const stdin = Buffer.concat(inputs.map(({ kind, bytes }) => {
+  const head = Buffer.alloc(5);
+  head.write(kind, 0, "latin1");
+  head.writeUInt32LE(bytes.length, 1);
+  return Buffer.concat([head, Buffer.from(bytes)]);
+}));
+const run = spawnSync(decoder, { input: stdin, maxBuffer: 64 << 20 });
+if (run.status !== 0) {
+  console.error(`summary_decode exited with ${run.status}: ${run.stderr}`);
+  process.exit(1);
+}
+const lines = run.stdout.toString("utf8").trimEnd().split("\n");
+assert.equal(lines.length, checks.length, "one result per input");
+lines.forEach((line, i) => checks[i](JSON.parse(line)));
+console.log(`ok ${checks.length} inputs`);
@@ -0,0 +1,172 @@
+// tz_test.cpp - Checks tz_rule.h against glibc, and times it against the TzGuard path it replaced.
+//
+// Every zone the device can be given (the "tz" of each park in parks.json, and the resort and
+// device zones the web UI in html.h offers) is compiled with tzRuleParse() and compared with glibc's
+// own POSIX TZ handling (TZ set once, localtime_r()): the local date and time of day hourly over
+// 2025-2026 and on both sides of every DST transition, and tzNextLocalMidnight() daily. glibc, like
+// newlib, takes the transitions of the instant's UTC year.
+//
+// The benchmark then converts the same instants the way TzGuard did on every call (setenv("TZ"),
+// tzset(), localtime_r(), then restoring TZ) and through the compiled rule, and prints both times.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tz_rule.h"
+
+#ifndef PARKPAL_DIR
+#define PARKPAL_DIR ".."
+#endif
+
+static const int64_t FROM = 1735689600; // 2025-01-01 00:00 UTC
+static const int64_t TO = 1798761600;   // 2027-01-01 00:00 UTC
+
+static int failures = 0;
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream s;
+    s << in.rdbuf();
+    return s.str();
+}
+
+// Every string in `text` that follows `prefix` (which ends with the opening quote), e.g.
+// `"tz": "JST-9"`, without duplicates.
+static void collect(const std::string& text, const std::string& prefix, std::vector<std::string>& out) {
+    const char quote = prefix.back();
+    for (size_t p = text.find(prefix); p != std::string::npos; p = text.find(prefix, p + 1)) {
+        const size_t open = p + prefix.size(), close = text.find(quote, open);
+        if (close == std::string::npos) break;
+        const std::string tz = text.substr(open, close - open);
+        bool seen = false;
+        for (const std::string& z : out) seen = seen || z == tz;
+        if (!seen) out.push_back(tz);
+    }
+}
+
+static std::vector<int64_t> instantsFor(const TzRule& rule) {
+    std::vector<int64_t> out;
+    for (int64_t t = FROM; t < TO; t += 3600) out.push_back(t);
+    if (rule.hasDst) {
+        for (int y = 2025; y <= 2026; y++) {
+            for (const bool start : { true, false }) {
+                const int64_t t = tzTransitionUtc(rule, y, start);
+                for (const int64_t dt : { -3601LL, -3600LL, -1LL, 0LL, 1LL, 3599LL, 3600LL }) out.push_back(t + dt);
+            }
+        }
+    }
+    return out;
+}
+
+static void localTimeViaEnv(const char* tz, time_t t, struct tm& out) {
+    const char* cur = getenv("TZ");
+    const std::string prev = cur ? cur : "";
+    setenv("TZ", tz, 1);
+    tzset();
+    localtime_r(&t, &out);
+    setenv("TZ", prev.c_str(), 1);
+    tzset();
+}
+
+static void checkZone(const char* tz) {
+    TzRule rule;
+    if (!tzRuleParse(tz, rule)) {
+        printf("FAIL %s: does not parse\n", tz);
+        failures++;
+        return;
+    }
+    setenv("TZ", tz, 1);
+    tzset();
+    int mismatches = 0;
+    const std::vector<int64_t> instants = instantsFor(rule);
+    for (const int64_t t : instants) {
+        const time_t tt = (time_t)t;
+        struct tm e;
+        localtime_r(&tt, &e);
+        int y, m, d;
+        int32_t secs;
+        tzLocalDate(rule, t, y, m, d, &secs);
+        if (y != e.tm_year + 1900 || m != e.tm_mon + 1 || d != e.tm_mday ||
+            secs != e.tm_hour * 3600 + e.tm_min * 60 + e.tm_sec) {
+            if (mismatches++ < 5)
+                printf("  %s at %lld: %04d-%02d-%02d +%ds, glibc %04d-%02d-%02d %02d:%02d:%02d\n", tz, (long long)t, y,
+                       m, d, secs, e.tm_year + 1900, e.tm_mon + 1, e.tm_mday, e.tm_hour, e.tm_min, e.tm_sec);
+        }
+    }
+    // The next local midnight is the first instant whose glibc date differs from the date at t.
+    for (int64_t t = FROM + 1234; t < TO; t += 86400) {
+        const int64_t next = tzNextLocalMidnight(rule, t);
+        const time_t a = (time_t)t, before = (time_t)(next - 1), after = (time_t)next;
+        struct tm ta, tb, tc;
+        localtime_r(&a, &ta);
+        localtime_r(&before, &tb);
+        localtime_r(&after, &tc);
+        if (next <= t || tb.tm_yday != ta.tm_yday || tc.tm_yday == ta.tm_yday) {
+            if (mismatches++ < 5) printf("  %s: next local midnight after %lld is %lld\n", tz, (long long)t, (long long)next);
+        }
+    }
+    unsetenv("TZ");
+    tzset();
+    if (mismatches) {
+        printf("FAIL %s: %d conversions differ from glibc\n", tz, mismatches);
+        failures++;
+    } else {
+        printf("ok %s (%zu instants)\n", tz, instants.size());
+    }
+}
+
+static void benchmark(const std::vector<std::string>& zones) {
+    using Clock = std::chrono::steady_clock;
+    size_t conversions = 0;
+    Clock::duration env{}, compiled{};
+    long checksum = 0; // Keeps the compiled loop from being optimised away
+    for (const std::string& tz : zones) {
+        TzRule rule;
+        tzRuleParse(tz.c_str(), rule);
+        const std::vector<int64_t> instants = instantsFor(rule);
+        const Clock::time_point t0 = Clock::now();
+        for (const int64_t t : instants) {
+            struct tm e;
+            localTimeViaEnv(tz.c_str(), (time_t)t, e);
+            checksum += e.tm_mday;
+        }
+        const Clock::time_point t1 = Clock::now();
+        for (const int64_t t : instants) {
+            int y, m, d;
+            tzLocalDate(rule, t, y, m, d);
+            checksum -= d;
+        }
+        compiled += Clock::now() - t1;
+        env += t1 - t0;
+        conversions += instants.size();
+    }
+    const auto ns = [&](Clock::duration d) {
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / conversions;
+    };
+    printf("bench: %zu conversions, setenv+tzset %.0f ns each, compiled rule %.1f ns each (checksum %ld)\n",
+           conversions, ns(env), ns(compiled), checksum);
+}
+
+int main() {
+    std::vector<std::string> zones;
+    collect(readFile(PARKPAL_DIR "/parks.json"), "\"tz\": \"", zones);
+    const size_t parkZones = zones.size();
+    const std::string html = readFile(PARKPAL_DIR "/html.h");
+    collect(html, "tz: \"", zones); // RESORTS
+    collect(html, "tz: '", zones);   // DEVICE_TIMEZONES
+    if (!parkZones || zones.size() == parkZones) {
+        printf("FAIL: no zones found in parks.json or html.h\n");
+        return 1;
+    }
+    for (const std::string& tz : zones) checkZone(tz.c_str());
+    benchmark(zones);
+    return failures ? 1 : 0;
+}
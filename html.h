@@ -778,7 +778,7 @@ static const char INDEX_HTML[] PROGMEM = R"html(
         <h2 class="card-title">Trip Settings</h2>
         <label>
           <span class="label-text">Trip name</span>
-          <input type="text" id="trip_name" placeholder="Tokyo Disney" maxlength="40">
+          <input type="text" id="trip_name" placeholder="Tokyo Disney" maxlength="40" data-max-bytes="47">
         </label>
         <p class="helper">Optional. If blank, ParkPal will pick a default based on your selected park(s).</p>
         <label class="toggle-row">
@@ -899,19 +899,19 @@ static const char INDEX_HTML[] PROGMEM = R"html(
       <input type="hidden" id="cd-id">
       <label>
         <span class="label-text">Label Line 1</span>
-        <input type="text" id="cd-label-1" placeholder="e.g., CHRISTMAS">
+        <input type="text" id="cd-label-1" placeholder="e.g., CHRISTMAS" data-max-bytes="47">
       </label>
       <label>
         <span class="label-text">Label Line 2 (optional)</span>
-        <input type="text" id="cd-label-2" placeholder="e.g., COUNTDOWN">
+        <input type="text" id="cd-label-2" placeholder="e.g., COUNTDOWN" data-max-bytes="47">
       </label>
       <label>
         <span class="label-text">Label Line 3 (optional)</span>
-        <input type="text" id="cd-label-3">
+        <input type="text" id="cd-label-3" data-max-bytes="47">
       </label>
       <label>
         <span class="label-text">Label Line 4 (optional)</span>
-        <input type="text" id="cd-label-4">
+        <input type="text" id="cd-label-4" data-max-bytes="47">
       </label>
       <label>
         <span class="label-text">Repeat</span>
@@ -1022,9 +1022,13 @@ const RESORTS = {
   }
 };
 
+// Device limits (parkpal_types.h)
+const MAX_COUNTDOWNS = 16;
+
 // State
 let cfg = {};
 let rideCache = {};
+let ridesInflight = {};
 let currentPick = { parkId: null, slot: null };
 
 // Popular/iconic ride suggestions used to pre-fill the first 6 slots when a park is first enabled.
@@ -1121,6 +1125,23 @@ async function maybeAutofillPopularRides(parkId) {
 const $ = id => document.getElementById(id);
 const $$ = (sel, root = document) => [...root.querySelectorAll(sel)];
 
+// Text the firmware keeps in fixed byte buffers (FixedString<47>) is limited in UTF-8 bytes:
+// maxlength counts UTF-16 units, and an accented letter or emoji takes 2-4 bytes.
+const UTF8 = new TextEncoder();
+
+function clipUtf8(s, maxBytes) {
+  if (UTF8.encode(s).length <= maxBytes) return s;
+  let out = '';
+  let bytes = 0;
+  for (const ch of s) { // Whole code points
+    const n = UTF8.encode(ch).length;
+    if (bytes + n > maxBytes) break;
+    out += ch;
+    bytes += n;
+  }
+  return out;
+}
+
 function escapeHtml(v) {
   return String(v ?? '').replace(/[&<>"']/g, ch => ({
     '&': '&amp;',
@@ -1249,7 +1270,7 @@ function gatherConfig() {
   cfg.resort = $('resort-selector').value;
   cfg.trip_enabled = $('trip_enabled').checked;
   cfg.trip_date = $('trip_date').value || '';
-  cfg.trip_name = ($('trip_name').value || '').trim();
+  cfg.trip_name = clipUtf8(($('trip_name').value || '').trim(), 47);
   cfg.units = $('units').value;
   cfg.countdowns_tz = $('device_tz').value;
   
@@ -1362,6 +1383,8 @@ async function renderParksAccordions() {
   
   const resort = RESORTS[cfg.resort || 'orlando'];
   const enabledParks = $$('.park-check.checked').map(el => parseInt(el.dataset.parkId));
+  // Warm the ride lists for every enabled park in one request (autofill and the picker use them).
+  fetchRidesForParks(enabledParks);
   
   for (const parkId of enabledParks) {
     const park = resort.parks[parkId];
@@ -1417,21 +1440,45 @@ async function renderParksAccordions() {
 // Ride Picker
 // ==============================================
 
-async function fetchRides(parkId) {
-  if (rideCache[parkId]) return rideCache[parkId];
-  
-  try {
-    const res = await fetch(`/api/rides?park=${parkId}`);
-    const data = await res.json();
-    const rides = data.rides || data.parks?.[0]?.rides || [];
-    rideCache[parkId] = rides;
-    return rides;
-  } catch (e) {
-    console.error('Failed to fetch rides:', e);
-    return [];
+// The device answers from its own ride cache and fetches misses in the background (202 with
+// "pending"), so poll until every park has arrived or failed.
+async function pollRides(parkIds) {
+  let want = parkIds;
+  let delay = 400;
+  for (let attempt = 0; want.length && attempt < 15; attempt++) {
+    try {
+      const res = await fetch(`/api/rides?parks=${want.join(',')}`);
+      const data = await res.json();
+      for (const p of (data.parks || [])) rideCache[p.park] = p.rides || [];
+      const pending = new Set((data.pending || []).map(Number));
+      want = want.filter(id => pending.has(id));
+    } catch (e) {
+      console.error('Failed to fetch rides:', e);
+      return;
+    }
+    if (want.length) {
+      await new Promise(r => setTimeout(r, delay));
+      delay = Math.min(delay * 1.5, 2000);
+    }
   }
 }
 
+// One request for every park not already cached or on its way.
+function fetchRidesForParks(parkIds) {
+  const ids = [...new Set(parkIds.map(Number))].filter(id => id > 0 && !rideCache[id]);
+  const want = ids.filter(id => !ridesInflight[id]);
+  if (want.length) {
+    const p = pollRides(want).finally(() => { for (const id of want) delete ridesInflight[id]; });
+    for (const id of want) ridesInflight[id] = p;
+  }
+  return Promise.all(ids.map(id => ridesInflight[id]).filter(Boolean));
+}
+
+async function fetchRides(parkId) {
+  if (!rideCache[parkId]) await fetchRidesForParks([parkId]);
+  return rideCache[parkId] || [];
+}
+
 async function openRidePicker(parkId, slot) {
   currentPick = { parkId, slot };
   
@@ -1553,6 +1600,10 @@ function openAddCountdown() {
 
 function addCountdownFromPreset(preset) {
   closeModal();
+  if (cfg.countdowns.length >= MAX_COUNTDOWNS) {
+    alert(`You can have up to ${MAX_COUNTDOWNS} countdowns.`);
+    return;
+  }
   
   const id = `cd_${Date.now()}`;
   let template = { id, label: [], repeat: 'yearly', accent: 'auto', include_in_cycle: true, icon: 'auto' };
@@ -1633,10 +1684,10 @@ function saveCountdown() {
   }
   
   cd.label = [
-    $('cd-label-1').value.trim(),
-    $('cd-label-2').value.trim(),
-    $('cd-label-3').value.trim(),
-    $('cd-label-4').value.trim()
+    clipUtf8($('cd-label-1').value.trim(), 47),
+    clipUtf8($('cd-label-2').value.trim(), 47),
+    clipUtf8($('cd-label-3').value.trim(), 47),
+    clipUtf8($('cd-label-4').value.trim(), 47)
   ];
   
   if (cd.label.every(l => !l)) {
@@ -1742,6 +1793,14 @@ $('cd-repeat').addEventListener('change', updateRepeatFields);
 // Ride search
 $('ride-search').addEventListener('input', filterRides);
 
+// Byte limits
+$$('input[data-max-bytes]').forEach(el => {
+  el.addEventListener('input', () => {
+    const clipped = clipUtf8(el.value, Number(el.dataset.maxBytes));
+    if (clipped !== el.value) el.value = clipped;
+  });
+});
+
 // Buttons
 $('btn-reload').addEventListener('click', loadConfig);
 $('btn-save').addEventListener('click', saveConfig);
@@ -7,6 +7,7 @@
 */
 #include <WiFi.h>
 #include <HTTPClient.h>
+#include <WiFiClientSecure.h>
 #include <ArduinoJson.h>
 #include <time.h>
 #include <SPI.h>
@@ -17,9 +18,22 @@
 #include <DNSServer.h>
 #include <vector>
 #include <esp_system.h>
+#include <esp_partition.h>
+#include <esp_timer.h>
+#include <esp_sleep.h>
+#include <driver/rtc_io.h>
+#include <esp_sntp.h>
 
 #include "parkpal_types.h"
 #include "WeatherIcons.h"
+#include "worker_tls.h"
+#include "summary_codec.h"
+#include "ride_catalog.h"
+#include "full_frame_display.h"
+#include "display_list.h"
+#include "text_metrics.h"
+#include "tz_rule.h"
+#include "countdown_cycle.h"
 
 // ---- Logging ----
 // Set to 1 to enable verbose Serial debug logs (Wi-Fi scans, event spam, etc.)
@@ -41,6 +55,8 @@ static unsigned long last_wifi_scan_ms = 0;
 static bool have_target_bssid = false;
 static uint8_t target_bssid[6] = {0};
 static int32_t target_channel = 0;
+static volatile bool worker_conn_stale = false; // set on STA disconnect; the Worker socket is dead
+static volatile bool wifi_fast_save_pending = false; // set on GOT_IP; the AP/lease record may need saving
 
 struct WiFiCandidate {
     uint8_t bssid[6];
@@ -224,20 +240,38 @@ static String normApiBaseUrl(String s) {
     return s;
 }
 
-static inline String apiUrl(const char* path) {
-    // `path` should start with "/v1/..."
-    return API_BASE_URL + path;
-}
 const uint32_t REFRESH_MS = 1800000; // 30 min
+const uint32_t REFRESH_FAST_MS = 600000; // 10 min: around opening, or while favourite waits move fast
+const uint32_t REFRESH_CLOSED_MAX_MS = 6UL * 3600UL * 1000UL; // Longest step while every park is closed
+const uint32_t ROPE_DROP_LEAD_S = 1800; // Fast refreshes start this long before the usual opening...
+const uint32_t ROPE_DROP_WINDOW_S = 5400; // ...and last until this long after it
+const uint8_t VOLATILITY_FAST_MIN_PER_H = 20; // Favourite waits moving this fast count as fast-moving
+const uint32_t PARK_CACHE_TTL_SLACK_MS = 60000; // A fetch ends seconds into its tick; see parkCacheFresh()
+const uint32_t PARK_CACHE_TTL_MIN_MS = 60000; // Shortest lifetime, the step to a rope-drop window a minute away
+const uint32_t PARK_CACHE_GRACE_MS = 3600000; // Past its lifetime, the cache still stands in for a failed refetch
 const uint32_t WIFI_RECONNECT_INTERVAL_MS = 30000; // Don't spam reconnect attempts
 const uint32_t WIFI_CONNECT_TIMEOUT_MS = 20000;
 const uint32_t HTTP_TIMEOUT_MS = 7000; // Bounds TLS handshake + request/response
 const uint32_t API_ERROR_RETRY_MS = 120000; // Retry sooner after transient API errors
+const uint32_t SUMMARY_PREFETCH_LEAD_MS = 90000; // Background fetch this long before the tick that needs it
+const uint32_t COUNTDOWN_TICK_SLACK_MS = 5000; // Countdown ticks land this long after midnight / a cycle step
+const uint32_t NTP_SYNC_TIMEOUT_MS = 15000;
 const uint8_t API_FAIL_STREAK_WIFI_RESET = 3;
 const uint32_t WIFI_AP_FALLBACK_AFTER_MS = 5UL * 60UL * 1000UL; // 5 min
 const uint32_t FACTORY_RESET_HOLD_MS = 8000;
 const int BOOT_PIN = 0; // usually GPIO0
 
+// Opt-in battery mode: deep sleep between refreshes (see "Deep sleep" below).
+#ifndef PARKPAL_DEEP_SLEEP
+#define PARKPAL_DEEP_SLEEP 0
+#endif
+const uint32_t SLEEP_UI_AWAKE_MS = 10UL * 60UL * 1000UL; // Web UI window after power-on or a BOOT press
+const uint32_t SLEEP_MIN_MS = 10000;
+const uint32_t SLEEP_CLOCK_RESYNC_S = 20UL * 3600UL; // NTP on a timer wake once the last sync is this old
+// Board current draw used for the average-current estimate in /api/metrics (measure yours).
+const float SLEEP_AWAKE_MA = 110.0f;
+const float SLEEP_ASLEEP_MA = 0.5f;
+
 static int last_http_code = 0;
 
 // ---- E-paper (Waveshare ESP32 + 7.5” HD tri-color) ----
@@ -249,35 +283,23 @@ static int last_http_code = 0;
 #define EPD_MOSI 14
 using Panel = GxEPD2_750c_Z90;
 const uint16_t PAGE_H = 64;
-GxEPD2_3C<Panel, PAGE_H> display(Panel(EPD_CS, EPD_DC, EPD_RST, EPD_BUSY));
+// Render each frame in one pass from a PSRAM framebuffer when the board has PSRAM (1), or always
+// page through PAGE_H-line bands (0). /api/render_mode switches at runtime for comparisons.
+#ifndef PARKPAL_FULL_FRAME
+#define PARKPAL_FULL_FRAME 1
+#endif
+FullFrameDisplay<Panel, PAGE_H> display(Panel(EPD_CS, EPD_DC, EPD_RST, EPD_BUSY));
 
 // ---- Fonts ----
-#include <Fonts/FreeSans9pt7b.h>
-#include <Fonts/FreeSans12pt7b.h>
-#include <Fonts/FreeSansBold12pt7b.h>
-#include <Fonts/FreeSansBold18pt7b.h>
-#include <Fonts/FreeSansBold24pt7b.h>
-// Optional custom giant numeric font
-// #include "BigDigits_120pt.h"
-
-const int16_t BORDER_MARGIN = 75; // The new margin for all sides
-
-const GFXfont* const LABEL_FONT = &FreeSansBold18pt7b;
-#ifdef BigDigits_120pt_h
-extern const GFXfont BigDigits_120pt;
-const GFXfont* const NUM_FONT = &BigDigits_120pt;
-#else
-const GFXfont* const NUM_FONT = &FreeSansBold24pt7b;
-#endif
-const GFXfont* const DAYS_FONT = &FreeSansBold18pt7b;
-const GFXfont* const AGE_FONT = &FreeSans12pt7b;
-const GFXfont* const MSG_FONT = &FreeSansBold12pt7b;
+#include "render_fonts.h"
 
 // -------------------- Web / NVS globals --------------------
 AsyncWebServer server(80);
 Preferences prefs;
 volatile bool config_changed = false;
+volatile bool config_snapshot_dirty = false; // Parsed config (and its NVS blob) no longer match config_json
 volatile bool refresh_now = false;
+volatile int8_t render_mode_request = -1; // From /api/render_mode: 0 paged, 1 full-frame; queued by loop()
 
 // -------------------- Config (JSON) --------------------
 static const char* DEFAULT_CONFIG = R"json({
@@ -310,8 +332,10 @@ String loadConfigJson() {
 
 bool saveConfigJson(const String& s) {
     prefs.begin("parkpal", false);
+    prefs.remove("config_bin"); // Stale as soon as the JSON changes
     bool ok = prefs.putString("config_json", s) > 0;
     prefs.end();
+    config_snapshot_dirty = true;
     if (ok) config_changed = true;
     return ok;
 }
@@ -360,70 +384,81 @@ static String regionForParkId(int parkId) {
     return "orlando";
 }
 
-static String parkNameForId(int parkId) {
-    return (parkId == 6) ? "Magic Kingdom" :
-           (parkId == 5) ? "EPCOT" :
-           (parkId == 7) ? "Hollywood Studios" :
-           (parkId == 8) ? "Animal Kingdom" :
-           (parkId == 16) ? "Disneyland" :
-           (parkId == 17) ? "Disney California Adventure" :
-           (parkId == 274) ? "Tokyo Disneyland" :
-           (parkId == 275) ? "Tokyo DisneySea" :
-           String("Park ") + parkId;
+// Unknown parks are named "Park <id>", formatted into `buf`.
+static const char* parkNameForId(int parkId, char* buf, size_t bufSize) {
+    const char* name = (parkId == 6) ? "Magic Kingdom" :
+                       (parkId == 5) ? "EPCOT" :
+                       (parkId == 7) ? "Hollywood Studios" :
+                       (parkId == 8) ? "Animal Kingdom" :
+                       (parkId == 16) ? "Disneyland" :
+                       (parkId == 17) ? "Disney California Adventure" :
+                       (parkId == 274) ? "Tokyo Disneyland" :
+                       (parkId == 275) ? "Tokyo DisneySea" :
+                       nullptr;
+    if (name) return name;
+    snprintf(buf, bufSize, "Park %d", parkId);
+    return buf;
 }
 
-static String inferTripNameFromParks(const String& resort, const int* parks, int parks_n) {
+static const char* inferTripNameFromParks(const char* resort, const int* parks, int parks_n, char* buf, size_t bufSize) {
     if (parks_n <= 0) return "My Trip";
-    if (parks_n == 1 && parks) return parkNameForId(parks[0]);
-    if (resort == "tokyo") return "Tokyo Disney";
-    if (resort == "california") return "Disneyland";
+    if (parks_n == 1 && parks) return parkNameForId(parks[0], buf, bufSize);
+    if (strcmp(resort, "tokyo") == 0) return "Tokyo Disney";
+    if (strcmp(resort, "california") == 0) return "Disneyland";
     return "Disney World";
 }
 
 String normalize(const String& in) {
-    String s = in;
-    s.replace("’", "'");
-    s.replace("‘", "'");
-    s.replace("“", "\"");
-    s.replace("”", "\"");
-    s.replace("–", "-");
-    s.replace("—", "-");
-    s.replace(" / ", "/");
-    s.replace(" /", "/");
-    s.replace("/ ", "/");
-    s.replace("™", "");
-    s.replace("®", "");
-    while (s.indexOf("  ") >= 0) s.replace("  ", " ");
-    s.trim();
-    s.toLowerCase();
-    return s;
+    std::vector<char> s(in.c_str(), in.c_str() + in.length() + 1);
+    rideNameNormalize(s.data());
+    return String(s.data());
+}
+
+// -------------------- Time zones --------------------
+// The zones in the config (parks_tz, countdowns_tz) compiled once into TzRules (tz_rule.h), keyed
+// by the TZ string. Local dates never go through the TZ environment variable, so no task sees
+// another's zone and nothing re-parses the string per conversion.
+struct TzCacheEntry {
+    bool used = false;
+    TzString tz;
+    TzRule rule;
+};
+static TzCacheEntry tz_cache[4];
+static int tz_cache_next = 0;
+static portMUX_TYPE tz_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Compiled rule for a POSIX TZ string; UTC when it doesn't parse, as with newlib.
+static TzRule tzRuleFor(const char* tz) {
+    TzRule rule;
+    portENTER_CRITICAL(&tz_mux);
+    for (const TzCacheEntry& e : tz_cache) {
+        if (e.used && e.tz == tz) {
+            rule = e.rule;
+            portEXIT_CRITICAL(&tz_mux);
+            return rule;
+        }
+    }
+    portEXIT_CRITICAL(&tz_mux);
+    if (!tzRuleParse(tz, rule)) DBG_PRINTF("TZ: can't parse \"%s\"; using UTC\n", tz ? tz : "");
+    portENTER_CRITICAL(&tz_mux);
+    TzCacheEntry& e = tz_cache[tz_cache_next];
+    tz_cache_next = (tz_cache_next + 1) % (int)(sizeof(tz_cache) / sizeof(tz_cache[0]));
+    e.used = true;
+    e.tz = tz;
+    e.rule = rule;
+    portEXIT_CRITICAL(&tz_mux);
+    return rule;
 }
 
-// -------------------- Timezone Guard Helper --------------------
-struct TzGuard {
-    String prev;
-    TzGuard(const char* tz) {
-        const char* cur = getenv("TZ");
-        if (cur) prev = String(cur);
-        setenv("TZ", tz, 1);
-        tzset();
-    }
-    ~TzGuard() {
-        setenv("TZ", prev.length() ? prev.c_str() : "", 1);
-        tzset();
-    }
-};
+static void localDateInTz(const char* tz, time_t t, int& y, int& m, int& d) {
+    tzLocalDate(tzRuleFor(tz), t, y, m, d);
+}
 
 static bool computeIsoDatePlusMonthsInTz(const char* tz, int addMonths, String& outIso) {
-    TzGuard guard(tz);
-    time_t now;
-    time(&now);
+    const time_t now = time(nullptr);
     if (now < 1700000000) return false; // NTP not ready
-    struct tm* lt = localtime(&now);
-    if (!lt) return false;
-    int y = lt->tm_year + 1900;
-    int m = lt->tm_mon + 1;
-    int d = lt->tm_mday;
+    int y, m, d;
+    localDateInTz(tz, now, y, m, d);
 
     m += addMonths;
     while (m > 12) { y++; m -= 12; }
@@ -488,7 +523,7 @@ bool parseConfig(RuntimeConfig& out) {
         dj.createNestedArray("countdowns");
         migrated = true;
     }
-    out.mode = dj["mode"].as<String>();
+    out.mode = dj["mode"] | "parks";
     {
         String raw = dj["resort"] | "orlando";
         String norm = normResort(raw);
@@ -498,17 +533,19 @@ bool parseConfig(RuntimeConfig& out) {
             migrated = true;
         }
     }
-    out.parks_tz = dj["parks_tz"].as<String>();
-    out.countdowns_tz = dj["countdowns_tz"].as<String>();
+    out.parks_tz = dj["parks_tz"] | "";
+    out.countdowns_tz = dj["countdowns_tz"] | "";
     JsonObject cs = dj["countdowns_settings"];
     out.countdownSettings.show_mode = cs["show_mode"] | "single";
     out.countdownSettings.primary_id = cs["primary_id"] | "";
     out.countdownSettings.cycle_every_n_refreshes = cs["cycle_every_n_refreshes"] | 1;
-    out.countdowns.clear();
+    out.countdowns_n = 0;
     JsonArray cd = dj["countdowns"].as<JsonArray>();
     if (!cd.isNull()) {
         for (JsonVariant v : cd) {
-            CountdownItem item;
+            if (out.countdowns_n >= MAX_COUNTDOWNS) break;
+            CountdownItem& item = out.countdowns[out.countdowns_n++];
+            item = CountdownItem();
             item.id = v["id"] | "";
             item.repeat = v["repeat"] | "yearly";
             item.year = v["year"] | 0;
@@ -520,9 +557,8 @@ bool parseConfig(RuntimeConfig& out) {
             item.icon = v["icon"] | "auto";
             JsonArray lbl = v["label"].as<JsonArray>();
             if (!lbl.isNull()) {
-                for (int i = 0; i < lbl.size() && i < 4; i++) item.label[i] = lbl[i].as<String>();
+                for (int i = 0; i < (int)lbl.size() && i < 4; i++) item.label[i] = lbl[i] | "";
             }
-            out.countdowns.push_back(item);
         }
     }
     out.metric = (String(dj["units"] | "metric") == "metric");
@@ -550,7 +586,8 @@ bool parseConfig(RuntimeConfig& out) {
     // If `trip_name` was never set (older configs), seed a stable default.
     // If the user explicitly clears it to blank, keep it blank and infer at render-time.
     if (!dj.containsKey("trip_name")) {
-        String inferred = inferTripNameFromParks(out.resort, out.parks, out.parks_n);
+        char nameBuf[24];
+        String inferred = inferTripNameFromParks(out.resort.c_str(), out.parks, out.parks_n, nameBuf, sizeof nameBuf);
         dj["trip_name"] = inferred;
         out.trip_name = inferred;
         migrated = true;
@@ -562,8 +599,8 @@ bool parseConfig(RuntimeConfig& out) {
         JsonArray leg = dj["rides_by_park"][String(pid)].as<JsonArray>(); // legacy labels
         for (int r = 0; r < 6; r++) {
             out.rideIds[i][r] = (ids.isNull() || r >= (int)ids.size()) ? 0 : (int)ids[r];
-            out.rideLabels[i][r] = (lbl.isNull() || r >= (int)lbl.size()) ? "" : String(lbl[r] | "");
-            out.legacyNames[i][r] = (leg.isNull() || r >= (int)leg.size()) ? "" : String(leg[r] | "");
+            out.rideLabels[i][r] = (lbl.isNull() || r >= (int)lbl.size()) ? "" : (lbl[r] | "");
+            out.legacyNames[i][r] = (leg.isNull() || r >= (int)leg.size()) ? "" : (leg[r] | "");
         }
     }
     if (migrated) {
@@ -574,10 +611,328 @@ bool parseConfig(RuntimeConfig& out) {
     return true;
 }
 
+// -------------------- Config snapshot --------------------
+// The parsed RuntimeConfig is kept between refreshes and persisted as a compact binary blob in NVS
+// ("config_bin"), so neither a refresh nor a reboot reparses the JSON. saveConfigJson() (a UI save
+// or a migration) drops both. A trip date still "auto" because the clock wasn't set is reparsed
+// once, on the first refresh after NTP; if that parse can't resolve it either, the result is kept.
+//
+// The blob starts with the magic and the size of RuntimeConfig, which changes with any field or
+// FixedString capacity; a blob that differs in either is ignored and the JSON reparsed. Bump the
+// magic's version when the field order or how a field is parsed changes without changing the size.
+static const uint32_t CONFIG_BLOB_MAGIC = 0x04525050; // "PPR" + version 4
+
+static RuntimeConfig config_snapshot;
+static bool config_snapshot_valid = false;
+static bool config_snapshot_tried_blob = false;
+static bool config_snapshot_parsed_with_time = false; // Parsed while the clock was set
+
+class ConfigBlobWriter {
+public:
+    std::vector<uint8_t> data;
+    void u8(uint8_t v) { data.push_back(v); }
+    void i32(int32_t v) {
+        for (int i = 0; i < 4; i++) data.push_back((uint8_t)((uint32_t)v >> (8 * i)));
+    }
+    template <size_t N> void str(const FixedString<N>& s) {
+        const uint16_t n = (uint16_t)s.length();
+        data.push_back((uint8_t)n);
+        data.push_back((uint8_t)(n >> 8));
+        data.insert(data.end(), s.c_str(), s.c_str() + n);
+    }
+};
+
+class ConfigBlobReader {
+public:
+    ConfigBlobReader(const uint8_t* p, size_t n) : p_(p), left_(n) {}
+    bool ok() const { return ok_; }
+    uint8_t u8() { return take(1) ? p_[-1] : 0; }
+    int32_t i32() {
+        if (!take(4)) return 0;
+        return (int32_t)((uint32_t)p_[-4] | ((uint32_t)p_[-3] << 8) | ((uint32_t)p_[-2] << 16) | ((uint32_t)p_[-1] << 24));
+    }
+    template <size_t N> void str(FixedString<N>& out) {
+        if (!take(2)) return;
+        const uint16_t n = p_[-2] | (p_[-1] << 8);
+        if (take(n)) out.assign((const char*)p_ - n, n);
+    }
+private:
+    bool take(size_t n) {
+        if (!ok_ || n > left_) return ok_ = false;
+        p_ += n;
+        left_ -= n;
+        return true;
+    }
+    const uint8_t* p_;
+    size_t left_;
+    bool ok_ = true;
+};
+
+static bool tripDateNeedsTime(const RuntimeConfig& c) {
+    return c.trip_enabled && (c.trip_date == "auto" || c.trip_date.length() < 10);
+}
+
+static void saveConfigBlob(const RuntimeConfig& c) {
+    ConfigBlobWriter w;
+    w.i32(CONFIG_BLOB_MAGIC);
+    w.i32((int32_t)sizeof(RuntimeConfig));
+    w.str(c.mode);
+    w.str(c.resort);
+    w.str(c.parks_tz);
+    w.str(c.countdowns_tz);
+    w.str(c.countdownSettings.show_mode);
+    w.str(c.countdownSettings.primary_id);
+    w.i32(c.countdownSettings.cycle_every_n_refreshes);
+    w.i32(c.countdowns_n);
+    for (int k = 0; k < c.countdowns_n; k++) {
+        const CountdownItem& item = c.countdowns[k];
+        w.str(item.id);
+        for (int i = 0; i < 4; i++) w.str(item.label[i]);
+        w.i32(item.year);
+        w.i32(item.month);
+        w.i32(item.day);
+        w.str(item.repeat);
+        w.i32(item.birth_year);
+        w.str(item.accent);
+        w.u8(item.include_in_cycle);
+        w.str(item.icon);
+    }
+    w.u8(c.metric);
+    w.u8(c.trip_enabled);
+    w.str(c.trip_date);
+    w.str(c.trip_name);
+    w.u8((uint8_t)c.parks_n);
+    for (int p = 0; p < c.parks_n; p++) {
+        w.i32(c.parks[p]);
+        for (int r = 0; r < 6; r++) {
+            w.i32(c.rideIds[p][r]);
+            w.str(c.rideLabels[p][r]);
+            w.str(c.legacyNames[p][r]);
+        }
+    }
+    prefs.begin("parkpal", false);
+    prefs.putBytes("config_bin", w.data.data(), w.data.size());
+    prefs.end();
+}
+
+static bool loadConfigBlob(RuntimeConfig& c) {
+    prefs.begin("parkpal", true);
+    const size_t n = prefs.isKey("config_bin") ? prefs.getBytesLength("config_bin") : 0;
+    std::vector<uint8_t> data(n);
+    if (n) prefs.getBytes("config_bin", data.data(), n);
+    prefs.end();
+    if (!n) return false;
+
+    ConfigBlobReader r(data.data(), n);
+    if ((uint32_t)r.i32() != CONFIG_BLOB_MAGIC) return false;
+    if (r.i32() != (int32_t)sizeof(RuntimeConfig)) return false;
+    r.str(c.mode);
+    r.str(c.resort);
+    r.str(c.parks_tz);
+    r.str(c.countdowns_tz);
+    r.str(c.countdownSettings.show_mode);
+    r.str(c.countdownSettings.primary_id);
+    c.countdownSettings.cycle_every_n_refreshes = r.i32();
+    c.countdowns_n = std::min<int>(r.i32(), MAX_COUNTDOWNS);
+    for (int k = 0; k < c.countdowns_n && r.ok(); k++) {
+        CountdownItem& item = c.countdowns[k];
+        r.str(item.id);
+        for (int i = 0; i < 4; i++) r.str(item.label[i]);
+        item.year = r.i32();
+        item.month = r.i32();
+        item.day = r.i32();
+        r.str(item.repeat);
+        item.birth_year = r.i32();
+        r.str(item.accent);
+        item.include_in_cycle = r.u8();
+        r.str(item.icon);
+    }
+    c.metric = r.u8();
+    c.trip_enabled = r.u8();
+    r.str(c.trip_date);
+    r.str(c.trip_name);
+    c.parks_n = std::min<int>(r.u8(), 4);
+    for (int p = 0; p < c.parks_n; p++) {
+        c.parks[p] = r.i32();
+        for (int i = 0; i < 6; i++) {
+            c.rideIds[p][i] = r.i32();
+            r.str(c.rideLabels[p][i]);
+            r.str(c.legacyNames[p][i]);
+        }
+    }
+    return r.ok();
+}
+
+// The config to render with, or nullptr if it can't be parsed. Only the render task calls this.
+const RuntimeConfig* currentConfig() {
+    if (config_snapshot_dirty) {
+        config_snapshot_dirty = false;
+        config_snapshot_valid = false;
+        config_snapshot_tried_blob = true; // The blob was removed with the save
+    }
+    const bool timeSet = time(nullptr) >= 1700000000;
+    if (config_snapshot_valid && !config_snapshot_parsed_with_time && timeSet && tripDateNeedsTime(config_snapshot)) {
+        config_snapshot_valid = false;
+    }
+    if (config_snapshot_valid) return &config_snapshot;
+
+    if (!config_snapshot_tried_blob) {
+        config_snapshot_tried_blob = true;
+        if (loadConfigBlob(config_snapshot)) {
+            DBG_PRINTLN("Config: loaded parsed snapshot from NVS");
+            config_snapshot_valid = true;
+            config_snapshot_parsed_with_time = false; // Whoever wrote it may not have had the time
+            return &config_snapshot;
+        }
+    }
+    if (!parseConfig(config_snapshot)) return nullptr;
+    saveConfigBlob(config_snapshot);
+    config_snapshot_valid = true;
+    config_snapshot_parsed_with_time = timeSet;
+    return &config_snapshot;
+}
+
 // -------------------- HTML UI --------------------
 #include "html.h"
 #include "setup_html.h"
 
+// -------------------- Wi-Fi fast reconnect --------------------
+// The last AP that worked (BSSID/channel) and its DHCP lease, kept in RTC memory and NVS. Reconnects
+// go straight to that AP on that channel, using the lease as a static config, so they skip both the
+// scan and DHCP. If that doesn't associate within WIFI_FAST_CONNECT_TIMEOUT_MS, the record is
+// dropped and the normal scan path runs. A lease is reused for WIFI_LEASE_REUSE_S; after that the
+// next reconnect still skips the scan but goes through DHCP again.
+const uint32_t WIFI_FAST_MAGIC = 0x57505001u; // "PPW" + version
+const uint32_t WIFI_FAST_CONNECT_TIMEOUT_MS = 3000;
+const uint32_t WIFI_LEASE_REUSE_S = 12UL * 3600UL;
+
+struct WiFiFastRecord {
+    uint32_t magic;
+    uint32_t ssidHash;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t reserved;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns1;
+    uint32_t dns2;
+    uint32_t leaseAt; // Unix time of the last DHCP lease (0 if the clock wasn't set yet)
+};
+
+static RTC_DATA_ATTR WiFiFastRecord rtc_wifi_fast;
+static WiFiFastRecord wifi_fast = {};
+static bool wifi_fast_loaded = false;
+static bool wifi_fast_attempt = false; // The current association is a fast one
+static bool wifi_fast_static = false;  // ...using the saved lease
+
+static uint32_t ssidHash(const String& ssid) {
+    uint32_t h = 2166136261u;
+    for (unsigned i = 0; i < ssid.length(); i++) h = (h ^ (uint8_t)ssid[i]) * 16777619u;
+    return h;
+}
+
+static void wifiFastLoad() {
+    if (wifi_fast_loaded) return;
+    wifi_fast_loaded = true;
+    if (rtc_wifi_fast.magic == WIFI_FAST_MAGIC) {
+        wifi_fast = rtc_wifi_fast;
+        return;
+    }
+    prefs.begin("parkpal", true);
+    if (prefs.getBytesLength("wifi_fast") == sizeof wifi_fast) prefs.getBytes("wifi_fast", &wifi_fast, sizeof wifi_fast);
+    prefs.end();
+    if (wifi_fast.magic != WIFI_FAST_MAGIC) wifi_fast = {};
+    rtc_wifi_fast = wifi_fast;
+}
+
+static void wifiUseDhcp() {
+    WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+}
+
+// Starts associating with the saved AP. False (nothing started) if there is no record for this SSID.
+static bool wifiFastBegin() {
+    wifiFastLoad();
+    if (wifi_fast.magic != WIFI_FAST_MAGIC || wifi_fast.channel == 0 || wifi_fast.ssidHash != ssidHash(WIFI_SSID)) return false;
+    const time_t now = time(nullptr);
+    wifi_fast_static = wifi_fast.ip && wifi_fast.leaseAt && now > 1700000000 &&
+                       (uint32_t)(now - wifi_fast.leaseAt) < WIFI_LEASE_REUSE_S;
+    if (wifi_fast_static) {
+        WiFi.config(IPAddress(wifi_fast.ip), IPAddress(wifi_fast.gateway), IPAddress(wifi_fast.subnet),
+                    IPAddress(wifi_fast.dns1), IPAddress(wifi_fast.dns2));
+    } else {
+        wifiUseDhcp();
+    }
+    memcpy(target_bssid, wifi_fast.bssid, 6);
+    target_channel = wifi_fast.channel;
+    have_target_bssid = true;
+    wifi_fast_attempt = true;
+    DBG_PRINTF("WiFi: fast reconnect to %02X:%02X:%02X:%02X:%02X:%02X ch=%d (%s)\n",
+               target_bssid[0], target_bssid[1], target_bssid[2], target_bssid[3], target_bssid[4], target_bssid[5],
+               (int)target_channel, wifi_fast_static ? "saved lease" : "DHCP");
+    WiFi.begin(WIFI_SSID.c_str(), WIFI_PASS.c_str(), target_channel, target_bssid, true);
+    return true;
+}
+
+// The saved AP didn't answer: drop the record so the next attempt scans and uses DHCP.
+static void wifiFastFailed() {
+    DBG_PRINTLN("WiFi: fast reconnect failed; falling back to a scan");
+    WiFi.disconnect(false);
+    if (wifi_fast_static) wifiUseDhcp();
+    wifi_fast_attempt = false;
+    wifi_fast_static = false;
+    wifi_fast.magic = 0;
+    rtc_wifi_fast.magic = 0;
+    have_target_bssid = false;
+    target_channel = 0;
+    last_wifi_scan_ms = 0;
+}
+
+// Records the current AP and lease. NVS is written only when they change.
+static void wifiFastSave() {
+    wifi_fast_save_pending = false;
+    if (WiFi.status() != WL_CONNECTED) return;
+    wifiFastLoad();
+    WiFiFastRecord rec = {};
+    rec.magic = WIFI_FAST_MAGIC;
+    rec.ssidHash = ssidHash(WIFI_SSID);
+    if (const uint8_t* bssid = WiFi.BSSID()) memcpy(rec.bssid, bssid, 6);
+    rec.channel = (uint8_t)WiFi.channel();
+    rec.ip = (uint32_t)WiFi.localIP();
+    rec.gateway = (uint32_t)WiFi.gatewayIP();
+    rec.subnet = (uint32_t)WiFi.subnetMask();
+    rec.dns1 = (uint32_t)WiFi.dnsIP(0);
+    rec.dns2 = (uint32_t)WiFi.dnsIP(1);
+    const time_t now = time(nullptr);
+    const bool sameLease = wifi_fast.magic == WIFI_FAST_MAGIC && wifi_fast.ip == rec.ip && wifi_fast.leaseAt;
+    rec.leaseAt = (wifi_fast_static || (sameLease && now <= 1700000000)) ? wifi_fast.leaseAt
+                  : (now > 1700000000 ? (uint32_t)now : 0);
+    wifi_fast_attempt = false;
+    if (memcmp(&rec, &wifi_fast, sizeof rec) == 0) return;
+    wifi_fast = rec;
+    rtc_wifi_fast = rec;
+    prefs.begin("parkpal", false);
+    prefs.putBytes("wifi_fast", &rec, sizeof rec);
+    prefs.end();
+}
+
+static void wifiFastForget() {
+    wifi_fast = {};
+    rtc_wifi_fast = {};
+    wifi_fast_loaded = true;
+    wifi_fast_attempt = false;
+    wifi_fast_static = false;
+    prefs.begin("parkpal", false);
+    prefs.remove("wifi_fast");
+    prefs.end();
+}
+
+static bool waitForWiFi(uint32_t timeoutMs) {
+    const unsigned long t0 = millis();
+    while (WiFi.status() != WL_CONNECTED && (uint32_t)(millis() - t0) < timeoutMs) delay(50);
+    return WiFi.status() == WL_CONNECTED;
+}
+
 // -------------------- Provisioning / Captive Portal --------------------
 DNSServer dnsServer;
 bool in_setup_mode = false;
@@ -599,6 +954,7 @@ static void resetWiFiTarget() {
     last_wifi_scan_ms = 0;
     wifi_candidates_n = 0;
     wifi_candidate_idx = 0;
+    wifiFastForget();
 }
 
 static void onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
@@ -607,6 +963,7 @@ static void onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
     switch (event) {
         case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
             last_wifi_disconnect_reason = info.wifi_sta_disconnected.reason;
+            worker_conn_stale = true;
             if (PARKPAL_DEBUG) {
                 DBG_PRINTF("WiFi event: STA_DISCONNECTED reason=%u (%s)\n",
                            (unsigned)last_wifi_disconnect_reason, wifiReasonToStr(last_wifi_disconnect_reason));
@@ -624,6 +981,7 @@ static void onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
             break;
         case ARDUINO_EVENT_WIFI_STA_GOT_IP:
             Serial.printf("WiFi connected: %s\n", WiFi.localIP().toString().c_str());
+            wifi_fast_save_pending = true;
             kickNTP();
             break;
         default:
@@ -669,7 +1027,11 @@ static void wipeProvisioningKeys(bool wipeConfigJson) {
     prefs.remove("wifi_pass");
     prefs.remove("api_base_url");
     prefs.remove("just_provisioned");
-    if (wipeConfigJson) prefs.remove("config_json");
+    if (wipeConfigJson) {
+        prefs.remove("config_json");
+        prefs.remove("config_bin");
+        config_snapshot_dirty = true;
+    }
     prefs.end();
     loadProvisioningKeys();
     resetWiFiTarget();
@@ -680,6 +1042,10 @@ static bool isProvisioned() {
 }
 
 // -------------------- Wi-Fi / NTP --------------------
+static bool wifi_power_save = false; // Modem sleep between beacons (countdown mode)
+static volatile bool clock_synced = false; // Set by SNTP; see resyncClock()
+static RTC_DATA_ATTR uint32_t rtc_clock_synced_at = 0; // Unix time of the last SNTP sync, kept through deep sleep
+
 void connectWiFi() {
     if (WIFI_SSID.length() == 0) return;
     DBG_PRINTF("WiFi: begin connect (ssid_len=%u pass_len=%u)\n", (unsigned)WIFI_SSID.length(), (unsigned)WIFI_PASS.length());
@@ -688,7 +1054,15 @@ void connectWiFi() {
     WiFi.mode(WIFI_STA);
     WiFi.setAutoReconnect(true);
     WiFi.persistent(false);
-    WiFi.setSleep(false);
+    WiFi.setSleep(wifi_power_save);
+    if (wifiFastBegin()) {
+        if (waitForWiFi(WIFI_FAST_CONNECT_TIMEOUT_MS)) {
+            wifiFastSave();
+            clearJustProvisionedFlag();
+            return;
+        }
+        wifiFastFailed();
+    }
     // Quick scan first so we can report auth/mode mismatches (WPA3-only, no AP found, etc.).
     scanForSsidIfNeeded(WIFI_SSID, /*force=*/true);
 
@@ -714,6 +1088,7 @@ void connectWiFi() {
         while (WiFi.status() != WL_CONNECTED && (uint32_t)(millis() - t0) < WIFI_CONNECT_TIMEOUT_MS) delay(200);
 
         if (WiFi.status() == WL_CONNECTED) {
+            wifiFastSave();
             clearJustProvisionedFlag();
             return;
         }
@@ -731,24 +1106,32 @@ void connectWiFi() {
     }
 }
 
+static void wifiScanAndBegin() {
+    // If we have a known-good BSSID/channel (common on mesh Wi-Fi), prefer it.
+    // Occasionally re-scan to adapt if the user moves the device or APs change.
+    scanForSsidIfNeeded(WIFI_SSID, /*force=*/!have_target_bssid);
+    if (isAuthishReason(last_wifi_disconnect_reason)) chooseNextCandidateIfAny();
+    if (have_target_bssid && target_channel > 0) {
+        WiFi.begin(WIFI_SSID.c_str(), WIFI_PASS.c_str(), target_channel, target_bssid, true);
+    } else {
+        WiFi.begin(WIFI_SSID.c_str(), WIFI_PASS.c_str());
+    }
+}
+
 bool ensureWiFiConnected(uint32_t timeoutMs = 0) {
     static unsigned long lastAttemptMs = 0;
-    if (WiFi.status() == WL_CONNECTED) return true;
+    if (WiFi.status() == WL_CONNECTED) {
+        if (wifi_fast_save_pending) wifiFastSave();
+        return true;
+    }
     if (WIFI_SSID.length() == 0) return false;
 
     const unsigned long now = millis();
     if (lastAttemptMs == 0 || (uint32_t)(now - lastAttemptMs) >= WIFI_RECONNECT_INTERVAL_MS) {
         lastAttemptMs = now;
         WiFi.disconnect(false);
-        // If we have a known-good BSSID/channel (common on mesh Wi-Fi), prefer it.
-        // Occasionally re-scan to adapt if the user moves the device or APs change.
-        scanForSsidIfNeeded(WIFI_SSID, /*force=*/!have_target_bssid);
-        if (isAuthishReason(last_wifi_disconnect_reason)) chooseNextCandidateIfAny();
-        if (have_target_bssid && target_channel > 0) {
-            WiFi.begin(WIFI_SSID.c_str(), WIFI_PASS.c_str(), target_channel, target_bssid, true);
-        } else {
-            WiFi.begin(WIFI_SSID.c_str(), WIFI_PASS.c_str());
-        }
+        if (wifi_fast_attempt) wifiFastFailed(); // The last attempt was a fast one and never connected
+        if (!wifiFastBegin()) wifiScanAndBegin();
         DBG_PRINTF("WiFi: reconnect attempt (status=%d)\n", (int)WiFi.status());
     }
 
@@ -756,9 +1139,16 @@ bool ensureWiFiConnected(uint32_t timeoutMs = 0) {
 
     const unsigned long start = millis();
     while (WiFi.status() != WL_CONNECTED && (uint32_t)(millis() - start) < timeoutMs) {
-        delay(200);
+        if (wifi_fast_attempt && (uint32_t)(millis() - lastAttemptMs) >= WIFI_FAST_CONNECT_TIMEOUT_MS) {
+            wifiFastFailed();
+            wifiScanAndBegin();
+        }
+        delay(50);
+    }
+    if (WiFi.status() == WL_CONNECTED) {
+        wifiFastSave();
+        clearJustProvisionedFlag();
     }
-    if (WiFi.status() == WL_CONNECTED) clearJustProvisionedFlag();
     return WiFi.status() == WL_CONNECTED;
 }
 
@@ -767,9 +1157,31 @@ void kickNTP() {
     configTime(0, 0, "pool.ntp.org", "time.nist.gov");
 }
 
+static void onClockSync(struct timeval* tv) {
+    rtc_clock_synced_at = (uint32_t)tv->tv_sec;
+    clock_synced = true;
+}
+
+// Restarts SNTP and waits for it to set the clock, even if the clock already looks valid: after a
+// deep sleep it has drifted with the RTC oscillator.
+static bool resyncClock(uint32_t timeoutMs) {
+    clock_synced = false;
+    kickNTP();
+    const unsigned long start = millis();
+    while (!clock_synced && (uint32_t)(millis() - start) < timeoutMs) delay(50);
+    return clock_synced;
+}
+
+// Countdown mode needs the radio only for the web UI, so it lets the modem sleep between beacons.
+// Parks mode keeps it awake for fetches and a responsive UI.
+static void wifiSetPowerSave(bool on) {
+    if (on == wifi_power_save) return;
+    wifi_power_save = on;
+    WiFi.setSleep(on);
+}
+
 void initNTP() {
     configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-    TzGuard guard("EST5EDT,M3.2.0/2,M11.1.0/2"); // default TZ for initial sync
     time_t now = 0;
     int tries = 0;
     while (now < 1700000000 && tries < 150) {
@@ -779,26 +1191,26 @@ void initNTP() {
     }
 }
 
-bool parseISODateYMD(const String& iso, int& year, int& month, int& day) {
-    if (iso.length() < 10) return false;
-    year = iso.substring(0, 4).toInt();
-    month = clampi(iso.substring(5, 7).toInt(), 1, 12);
-    day = clampi(iso.substring(8, 10).toInt(), 1, 31);
+bool parseISODateYMD(const char* iso, int& year, int& month, int& day) {
+    if (strnlen(iso, 10) < 10) return false;
+    const auto field = [iso](int off, int len) {
+        char b[5] = {};
+        memcpy(b, iso + off, len);
+        return atoi(b);
+    };
+    year = field(0, 4);
+    month = clampi(field(5, 2), 1, 12);
+    day = clampi(field(8, 2), 1, 31);
     day = clampDayOfMonth(year, month, day);
     return year >= 1970;
 }
 
 // -------------------- Time Calculation --------------------
-bool daysToDateInTz(const String& isoDate, const char* tz, int& outDays) {
-    TzGuard guard(tz);
-    time_t now;
-    time(&now);
+bool daysToDateInTz(const char* isoDate, const char* tz, int& outDays) {
+    const time_t now = time(nullptr);
     if (now < 1700000000) return false;
-    struct tm* lt = localtime(&now);
-    if (!lt) return false;
-    const int today_y = lt->tm_year + 1900;
-    const int today_m = lt->tm_mon + 1;
-    const int today_d = lt->tm_mday;
+    int today_y, today_m, today_d;
+    localDateInTz(tz, now, today_y, today_m, today_d);
 
     int y, m, d;
     if (!parseISODateYMD(isoDate, y, m, d)) return false;
@@ -811,19 +1223,13 @@ bool daysToDateInTz(const String& isoDate, const char* tz, int& outDays) {
 
 bool computeDaysToEvent(const CountdownItem& c, const char* tz, int& outDays, int& outTurnsAge) {
     // "once" past events -> show DONE! (days = 0)
-    TzGuard guard(tz);
-    time_t now;
-    time(&now);
+    const time_t now = time(nullptr);
     if (now < 1700000000) {
         outDays = -2;
         return false;
     }
-    struct tm* lt = localtime(&now);
-    if (!lt) {
-        outDays = -2;
-        return false;
-    }
-    int today_y = lt->tm_year + 1900, today_m = lt->tm_mon + 1, today_d = lt->tm_mday;
+    int today_y, today_m, today_d;
+    localDateInTz(tz, now, today_y, today_m, today_d);
     outDays = 0;
     outTurnsAge = 0;
     if (c.repeat == "once") {
@@ -862,39 +1268,469 @@ bool computeDaysToEvent(const CountdownItem& c, const char* tz, int& outDays, in
     }
 }
 
+// -------------------- Refresh metrics --------------------
+// Microsecond timings for each stage of a refresh, kept for the last METRICS_RING_N refreshes and
+// served by /api/metrics. Only the render task and the network task serving its fetch record;
+// other tasks sharing the Worker connection (rides catalog fetches) don't pollute a sample.
+const int METRICS_RING_N = 32;
+
+static RefreshSample metrics_ring[METRICS_RING_N];
+static int metrics_ring_next = 0;
+static int metrics_ring_count = 0;
+static portMUX_TYPE metrics_mux = portMUX_INITIALIZER_UNLOCKED;
+static RefreshSample metrics_cur;
+static TaskHandle_t metrics_task = nullptr; // Set while a refresh is being recorded
+static TaskHandle_t metrics_net_task = nullptr; // Fetches for the refresh; the render task waits meanwhile
+static int64_t metrics_start_us = 0;
+static int64_t epd_busy_last_us = 0;
+static const char* const METRIC_STAGE_NAMES[STAGE_COUNT] = {
+    "wifi", "dns", "connect", "http", "parse", "layout", "draw", "busy", "total"
+};
+
+static void metricsAdd(MetricStage stage, int64_t us) {
+    if (!metrics_task || us <= 0) return;
+    const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    if (task == metrics_task || task == metrics_net_task) metrics_cur.us[stage] += (uint32_t)us;
+}
+
+static void metricsParseHeap(uint32_t bytes) {
+    if (!metrics_task) return;
+    const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    if ((task == metrics_task || task == metrics_net_task) && bytes > metrics_cur.parse_heap) metrics_cur.parse_heap = bytes;
+}
+
+static void metricsBegin() {
+    metrics_cur = RefreshSample();
+    metrics_start_us = esp_timer_get_time();
+    metrics_task = xTaskGetCurrentTaskHandle();
+}
+
+static void metricsEnd() {
+    if (!metrics_task) return;
+    metrics_cur.us[STAGE_TOTAL] = (uint32_t)(esp_timer_get_time() - metrics_start_us);
+    metrics_task = nullptr;
+    const time_t now = time(nullptr);
+    metrics_cur.at = now > 1700000000 ? (uint32_t)now : (uint32_t)(millis() / 1000);
+    metrics_cur.heap_free = ESP.getFreeHeap();
+    metrics_cur.heap_min = ESP.getMinFreeHeap();
+    metrics_cur.heap_max_block = ESP.getMaxAllocHeap();
+    metrics_cur.full_frame = display.fullFrame();
+    portENTER_CRITICAL(&metrics_mux);
+    metrics_ring[metrics_ring_next] = metrics_cur;
+    metrics_ring_next = (metrics_ring_next + 1) % METRICS_RING_N;
+    if (metrics_ring_count < METRICS_RING_N) metrics_ring_count++;
+    portEXIT_CRITICAL(&metrics_mux);
+}
+
+// GxEPD2 calls this in its BUSY poll loop in place of delay(1). Consecutive calls belong to one
+// wait; the gap before the first call of a wait is not BUSY time.
+static void epdBusyCallback(const void*) {
+    const int64_t now = esp_timer_get_time();
+    if (now - epd_busy_last_us < 5000) metricsAdd(STAGE_BUSY, now - epd_busy_last_us);
+    epd_busy_last_us = now;
+    delay(1);
+}
+
+// Adds the time until stop() (or the end of scope) to one stage.
+class StageTimer {
+public:
+    explicit StageTimer(MetricStage stage) : stage_(stage), t0_(esp_timer_get_time()) {}
+    ~StageTimer() { stop(); }
+    void stop() {
+        if (t0_ < 0) return;
+        metricsAdd(stage_, esp_timer_get_time() - t0_);
+        t0_ = -1;
+    }
+private:
+    MetricStage stage_;
+    int64_t t0_;
+};
+
+// Times a page loop as STAGE_DRAW, leaving the BUSY waits inside it to STAGE_BUSY.
+class DrawTimer {
+public:
+    DrawTimer() : t0_(esp_timer_get_time()), busy0_(metrics_cur.us[STAGE_BUSY]) {}
+    ~DrawTimer() {
+        const int64_t busy = (int64_t)metrics_cur.us[STAGE_BUSY] - busy0_;
+        metricsAdd(STAGE_DRAW, esp_timer_get_time() - t0_ - busy);
+    }
+private:
+    int64_t t0_;
+    uint32_t busy0_;
+};
+
+// Records one refresh from construction to the end of runRefresh(), whichever way it exits.
+struct RefreshMetricsScope {
+    RefreshMetricsScope() { metricsBegin(); }
+    ~RefreshMetricsScope() { metricsEnd(); }
+};
+
+// Nearest-rank percentile over the samples where the stage ran at all (and, with fullFrame >= 0,
+// that were rendered in that mode).
+static uint32_t stagePercentile(const RefreshSample* samples, int n, int stage, int pct, int& ran, int fullFrame = -1) {
+    uint32_t vals[METRICS_RING_N];
+    ran = 0;
+    for (int i = 0; i < n; i++)
+        if (samples[i].us[stage] && (fullFrame < 0 || samples[i].full_frame == fullFrame)) vals[ran++] = samples[i].us[stage];
+    if (!ran) return 0;
+    std::sort(vals, vals + ran);
+    const int rank = (pct * ran + 99) / 100;
+    return vals[std::max(rank, 1) - 1];
+}
+
+void sleepStatsJson(JsonObject out); // Deep sleep section
+
+String metricsJson() {
+    RefreshSample samples[METRICS_RING_N];
+    int n = 0;
+    portENTER_CRITICAL(&metrics_mux);
+    n = metrics_ring_count;
+    for (int i = 0; i < n; i++) samples[i] = metrics_ring[(metrics_ring_next - n + i + METRICS_RING_N) % METRICS_RING_N];
+    portEXIT_CRITICAL(&metrics_mux);
+
+    DynamicJsonDocument doc(12 * 1024);
+    doc["uptime_s"] = millis() / 1000;
+    doc["units"] = "us";
+    JsonObject heap = doc.createNestedObject("heap");
+    heap["free"] = ESP.getFreeHeap();
+    heap["min_free"] = ESP.getMinFreeHeap();
+    heap["max_block"] = ESP.getMaxAllocHeap();
+    doc["samples"] = n;
+    JsonObject stages = doc.createNestedObject("stages");
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        int ran = 0;
+        JsonObject st = stages.createNestedObject(METRIC_STAGE_NAMES[s]);
+        st["p50"] = stagePercentile(samples, n, s, 50, ran);
+        st["p95"] = stagePercentile(samples, n, s, 95, ran);
+        st["max"] = stagePercentile(samples, n, s, 100, ran);
+        st["n"] = ran;
+    }
+    // Render-side stages split by mode, for comparing full-frame against paging on this board.
+    doc["render_mode"] = display.fullFrame() ? "full" : "paged";
+    JsonObject byMode = doc.createNestedObject("by_render_mode");
+    static const MetricStage RENDER_STAGES[] = { STAGE_LAYOUT, STAGE_DRAW, STAGE_BUSY, STAGE_TOTAL };
+    for (int mode = 0; mode < 2; mode++) {
+        JsonObject m;
+        for (MetricStage s : RENDER_STAGES) {
+            int ran = 0;
+            const uint32_t p50 = stagePercentile(samples, n, s, 50, ran, mode);
+            if (!ran) continue;
+            if (m.isNull()) m = byMode.createNestedObject(mode ? "full" : "paged");
+            JsonObject st = m.createNestedObject(METRIC_STAGE_NAMES[s]);
+            st["p50"] = p50;
+            st["p95"] = stagePercentile(samples, n, s, 95, ran, mode);
+            st["n"] = ran;
+        }
+    }
+    JsonArray recent = doc.createNestedArray("recent");
+    for (int i = n - 1; i >= 0; i--) { // Newest first
+        JsonObject r = recent.createNestedObject();
+        r["at"] = samples[i].at;
+        for (int s = 0; s < STAGE_COUNT; s++)
+            if (samples[i].us[s]) r[METRIC_STAGE_NAMES[s]] = samples[i].us[s];
+        r["heap_free"] = samples[i].heap_free;
+        r["heap_min"] = samples[i].heap_min;
+        r["heap_max_block"] = samples[i].heap_max_block;
+        if (samples[i].parse_heap) r["parse_heap"] = samples[i].parse_heap;
+        r["render_mode"] = samples[i].full_frame ? "full" : "paged";
+    }
+    if (PARKPAL_DEEP_SLEEP) sleepStatsJson(doc.createNestedObject("sleep"));
+    String out;
+    serializeJson(doc, out);
+    return out;
+}
+
 // -------------------- HTTP helpers --------------------
-bool httpPostJson(const char* url, const String& body, DynamicJsonDocument& outDoc) {
-    HTTPClient http;
-    http.begin(url);
-    http.setTimeout(HTTP_TIMEOUT_MS);
-    http.addHeader("Content-Type", "application/json");
-    int code = http.POST(body);
-    last_http_code = code;
-    if (code != 200) {
-        http.end();
+// Document budgets for filtered responses. The filters below keep only what the firmware reads,
+// so these are sized for the kept fields rather than for the raw Worker payloads.
+const size_t SUMMARY_DOC_BYTES = 3 * 1024;
+const size_t RIDES_DOC_BYTES = 12 * 1024;
+
+// /v1/summary: weather block + the (already favourites-only) ride rows used by renderParks().
+static StaticJsonDocument<256> makeSummaryFilter() {
+    StaticJsonDocument<256> filter;
+    filter["weather"] = true;
+    filter["park"]["rides"][0]["id"] = true;
+    filter["park"]["rides"][0]["name"] = true;
+    filter["park"]["rides"][0]["is_open"] = true;
+    filter["park"]["rides"][0]["wait_time"] = true;
+    return filter;
+}
+
+// /v1/rides: canonical id + name per ride (what the picker and slot migration read).
+static StaticJsonDocument<128> makeRidesFilter() {
+    StaticJsonDocument<128> filter;
+    filter["rides"][0]["id"] = true;
+    filter["rides"][0]["name"] = true;
+    filter["version"] = true;
+    return filter;
+}
+
+static const StaticJsonDocument<256> SUMMARY_FILTER = makeSummaryFilter();
+static const StaticJsonDocument<128> RIDES_FILTER = makeRidesFilter();
+
+// -------------------- Worker connection --------------------
+// One long-lived HTTPClient + socket to the Worker, shared by every API call. Requests go out with
+// keep-alive so back-to-back calls (retries, picker lookups, migrations) skip TCP/TLS setup, and
+// the host's address is cached so reconnects skip DNS. A socket that has idled past what the edge
+// will keep open, or that fails on reuse, is dropped and the request is retried on a fresh one.
+const uint32_t WORKER_DNS_TTL_MS = 60UL * 60UL * 1000UL; // 1 hour
+const uint32_t WORKER_IDLE_MAX_MS = 50000; // Close before the edge's keep-alive idle timeout
+
+struct WorkerEndpoint {
+    String source; // API_BASE_URL this was parsed from
+    bool https = false;
+    String host;
+    uint16_t port = 0;
+    String basePath; // Path prefix below the host (normally empty)
+};
+
+static WorkerEndpoint worker_ep;
+static WiFiClient worker_plain;
+static WorkerTlsClient worker_tls;
+static HTTPClient worker_http;
+static SemaphoreHandle_t worker_mutex = nullptr;
+static IPAddress worker_ip;
+static bool worker_ip_valid = false;
+static unsigned long worker_ip_at_ms = 0;
+static unsigned long worker_last_used_ms = 0;
+static bool worker_reused = false; // Last request went out on an already-open socket
+
+static bool parseWorkerEndpoint(const String& base, WorkerEndpoint& out) {
+    out = WorkerEndpoint();
+    out.source = base;
+    int hostStart;
+    if (base.startsWith("https://")) {
+        out.https = true;
+        out.port = 443;
+        hostStart = 8;
+    } else if (base.startsWith("http://")) {
+        out.port = 80;
+        hostStart = 7;
+    } else {
+        return false;
+    }
+    int pathStart = base.indexOf('/', hostStart);
+    String hostPort = pathStart < 0 ? base.substring(hostStart) : base.substring(hostStart, pathStart);
+    out.basePath = pathStart < 0 ? String("") : base.substring(pathStart);
+    const int colon = hostPort.indexOf(':');
+    if (colon >= 0) {
+        out.port = (uint16_t)hostPort.substring(colon + 1).toInt();
+        hostPort = hostPort.substring(0, colon);
+    }
+    out.host = hostPort;
+    return out.host.length() > 0 && out.port > 0;
+}
+
+static WiFiClient& workerClient() {
+    return worker_ep.https ? (WiFiClient&)worker_tls : worker_plain;
+}
+
+static void workerDropSocket() {
+    worker_plain.stop();
+    worker_tls.stop();
+}
+
+void workerConnInit() {
+    if (!worker_mutex) worker_mutex = xSemaphoreCreateMutex();
+    worker_http.setReuse(true);
+    worker_http.setTimeout(HTTP_TIMEOUT_MS);
+    static const char* responseHeaders[] = {"Content-Type", "ETag"};
+    worker_http.collectHeaders(responseHeaders, 2);
+}
+
+static bool workerLock() {
+    return worker_mutex && xSemaphoreTake(worker_mutex, pdMS_TO_TICKS(2 * HTTP_TIMEOUT_MS)) == pdTRUE;
+}
+
+static void workerUnlock() {
+    xSemaphoreGive(worker_mutex);
+}
+
+static bool workerResolve() {
+    const unsigned long now = millis();
+    if (worker_ip_valid && (uint32_t)(now - worker_ip_at_ms) < WORKER_DNS_TTL_MS) return true;
+    IPAddress ip;
+    StageTimer timer(STAGE_DNS);
+    if (WiFi.hostByName(worker_ep.host.c_str(), ip) != 1 || ip == IPAddress((uint32_t)0)) {
+        worker_ip_valid = false;
         return false;
     }
-    String payload = http.getString();
-    http.end();
-    return (deserializeJson(outDoc, payload) == DeserializationError::Ok);
+    worker_ip = ip;
+    worker_ip_valid = true;
+    worker_ip_at_ms = now;
+    return true;
+}
+
+// Make sure the shared socket is open, connecting by cached address when it isn't.
+// HTTPClient sees an already-connected client and goes straight to sending the request.
+static bool workerConnect() {
+    if (worker_ep.source != API_BASE_URL) {
+        workerDropSocket();
+        worker_ip_valid = false;
+        if (!parseWorkerEndpoint(API_BASE_URL, worker_ep)) return false;
+    }
+    if (worker_conn_stale || (uint32_t)(millis() - worker_last_used_ms) > WORKER_IDLE_MAX_MS) {
+        worker_conn_stale = false;
+        workerDropSocket();
+    }
+    WiFiClient& client = workerClient();
+    worker_reused = client.connected();
+    if (worker_reused) return true;
+    if (!workerResolve()) return false;
+    const unsigned long t0 = millis();
+    StageTimer timer(STAGE_CONNECT);
+    bool ok;
+    if (worker_ep.https) {
+        ok = worker_tls.connectResuming(worker_ip, worker_ep.port, worker_ep.host.c_str(), HTTP_TIMEOUT_MS) == 1;
+        Serial.printf("API: TLS %s in %lu ms (%s)\n", ok ? "handshake" : "handshake failed",
+                      (unsigned long)worker_tls.lastHandshakeMs,
+                      worker_tls.lastOfferedSession ? "resuming cached session" : "full");
+    } else {
+        ok = worker_plain.connect(worker_ip, worker_ep.port) == 1;
+    }
+    DBG_PRINTF("API: connect %s:%u %s in %lu ms\n", worker_ep.host.c_str(), (unsigned)worker_ep.port,
+               ok ? "ok" : "failed", (unsigned long)(millis() - t0));
+    if (!ok) {
+        workerDropSocket();
+        worker_ip_valid = false; // Re-resolve next time in case the address moved
+    }
+    return ok;
 }
 
-bool httpGetJson(const String& url, DynamicJsonDocument& outDoc) {
-    HTTPClient http;
-    http.begin(url);
-    http.setTimeout(HTTP_TIMEOUT_MS);
-    int code = http.GET();
+// Send one request on the shared connection. Returns the HTTP status (or a negative HTTPClient
+// error); on 200 the response body is left open for the caller to read before workerEnd().
+// With `ifNoneMatch` set, an unchanged resource comes back as a body-less 304.
+static int workerRequest(const char* method, const String& path, const String* body, const char* accept = nullptr, const char* ifNoneMatch = nullptr) {
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!workerConnect()) return HTTPC_ERROR_CONNECTION_REFUSED;
+        worker_http.begin(workerClient(), worker_ep.host, worker_ep.port, worker_ep.basePath + path, worker_ep.https);
+        if (body) worker_http.addHeader("Content-Type", "application/json");
+        if (accept) worker_http.addHeader("Accept", accept);
+        if (ifNoneMatch) worker_http.addHeader("If-None-Match", ifNoneMatch);
+        StageTimer timer(STAGE_HTTP);
+        const int code = body ? worker_http.sendRequest(method, *body) : worker_http.sendRequest(method);
+        timer.stop();
+        worker_last_used_ms = millis();
+        // A reused socket can be closed by the far end between requests; retry once on a new one.
+        if (code < 0 && worker_reused && attempt == 0) {
+            DBG_PRINTF("API: reused connection failed (%d), reconnecting\n", code);
+            workerDropSocket();
+            continue;
+        }
+        return code;
+    }
+    return HTTPC_ERROR_CONNECTION_LOST;
+}
+
+static void workerEnd(bool keepOpen) {
+    // end() keeps the socket when the server agreed to keep-alive. An error status or a failed
+    // parse leaves the stream position unknown, so that socket is not reused.
+    if (!keepOpen) workerDropSocket();
+    worker_http.end();
+}
+
+// Parse the response body straight off the socket when its length is known, so the payload is
+// never copied into a String. Chunked / unknown-length bodies fall back to a buffered read.
+static bool readJsonBody(HTTPClient& http, DynamicJsonDocument& outDoc, const JsonDocument* filter) {
+    StageTimer timer(STAGE_PARSE);
+    DeserializationError err;
+    // Heap held at the parse's peak: the document (allocated by the caller) plus whatever the body
+    // read took on top, sampled while the buffered copy is still alive.
+    const uint32_t freeBefore = ESP.getFreeHeap();
+    uint32_t freeDuring;
+    if (http.getSize() >= 0) {
+        WiFiClient& stream = http.getStream();
+        err = filter ? deserializeJson(outDoc, stream, DeserializationOption::Filter(*filter))
+                     : deserializeJson(outDoc, stream);
+        freeDuring = ESP.getFreeHeap();
+    } else {
+        String payload = http.getString();
+        err = filter ? deserializeJson(outDoc, payload, DeserializationOption::Filter(*filter))
+                     : deserializeJson(outDoc, payload);
+        freeDuring = ESP.getFreeHeap();
+    }
+    metricsParseHeap((uint32_t)outDoc.capacity() + (freeBefore > freeDuring ? freeBefore - freeDuring : 0));
+    DBG_PRINTF("HTTP: parsed %u/%u doc bytes (%s), heap free=%u min=%u maxblk=%u\n",
+               (unsigned)outDoc.memoryUsage(), (unsigned)outDoc.capacity(), err.c_str(),
+               (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMinFreeHeap(), (unsigned)ESP.getMaxAllocHeap());
+    return err == DeserializationError::Ok;
+}
+
+// `path` is relative to API_BASE_URL and should start with "/v1/...".
+static bool workerJson(const char* method, const String& path, const String* body, DynamicJsonDocument& outDoc, const JsonDocument* filter) {
+    if (!workerLock()) {
+        last_http_code = HTTPC_ERROR_CONNECTION_REFUSED;
+        return false;
+    }
+    const int code = workerRequest(method, path, body);
     last_http_code = code;
-    if (code != 200) {
-        http.end();
+    bool ok = false;
+    if (code == 200) ok = readJsonBody(worker_http, outDoc, filter);
+    workerEnd(ok);
+    workerUnlock();
+    return ok;
+}
+
+bool httpPostJson(const String& path, const String& body, DynamicJsonDocument& outDoc, const JsonDocument* filter = nullptr) {
+    return workerJson("POST", path, &body, outDoc, filter);
+}
+
+bool httpGetJson(const String& path, DynamicJsonDocument& outDoc, const JsonDocument* filter = nullptr) {
+    return workerJson("GET", path, nullptr, outDoc, filter);
+}
+
+// GET /v1/rides for one park, conditional on the catalog version already held (`haveVersion`).
+// Sets `notModified` instead of filling `outDoc` when the Worker answers 304.
+static bool fetchRidesCatalog(int parkId, const uint32_t* haveVersion, DynamicJsonDocument& outDoc, bool& notModified) {
+    notModified = false;
+    if (!workerLock()) {
+        last_http_code = HTTPC_ERROR_CONNECTION_REFUSED;
         return false;
     }
-    String payload = http.getString();
-    http.end();
-    return (deserializeJson(outDoc, payload) == DeserializationError::Ok);
+    char etag[16];
+    if (haveVersion) snprintf(etag, sizeof(etag), "\"c%08lx\"", (unsigned long)*haveVersion);
+    const int code = workerRequest("GET", "/v1/rides?park=" + String(parkId), nullptr, nullptr, haveVersion ? etag : nullptr);
+    last_http_code = code;
+    bool ok = false;
+    if (code == 304 && haveVersion) ok = notModified = true;
+    else if (code == 200) ok = readJsonBody(worker_http, outDoc, &RIDES_FILTER);
+    workerEnd(ok);
+    workerUnlock();
+    return ok;
+}
+
+// Reads a binary summary body (summary_codec.h) into `out` without touching the heap.
+static bool readSummaryBin(HTTPClient& http, ParkSummary& out) {
+    StageTimer timer(STAGE_PARSE);
+    const int size = http.getSize();
+    if (size <= 0 || size > (int)SUMMARY_BIN_MAX) return false;
+    uint8_t buf[SUMMARY_BIN_MAX];
+    if (http.getStream().readBytes(buf, size) != (size_t)size) return false;
+    return decodeSummaryBin(buf, size, out);
+}
+
+// JSON fallback for Workers that predate the binary format.
+static bool summaryFromJson(const JsonDocument& doc, ParkSummary& out) {
+    JsonObjectConst w = doc["weather"].as<JsonObjectConst>();
+    out.temp = w["temp"] | 0;
+    out.code = w["code"] | 0;
+    out.sunrise = w["sunrise"] | 0UL;
+    out.sunset = w["sunset"] | 0UL;
+    strlcpy(out.desc, w["desc"] | "—", sizeof(out.desc));
+    out.rides_n = 0;
+    for (JsonObjectConst ri : doc["park"]["rides"].as<JsonArrayConst>()) {
+        if (out.rides_n >= SUMMARY_MAX_RIDES) break;
+        RideStatus& r = out.rides[out.rides_n++];
+        r.id = ri["id"] | 0;
+        r.open = ri["is_open"] | false;
+        r.wait = ri["wait_time"] | 0;
+        strlcpy(r.name, ri["name"] | "—", sizeof(r.name));
+    }
+    return true;
 }
 
-bool fetchSummaryForPark(int parkId, bool metricUnits, const int rideIds[6], DynamicJsonDocument &doc) {
+bool fetchSummaryForPark(int parkId, bool metricUnits, const int rideIds[6], ParkSummary& out) {
     if (API_BASE_URL.length() == 0) return false;
     DynamicJsonDocument bodyDoc(1024);
     bodyDoc["park"] = parkId;
@@ -905,528 +1741,843 @@ bool fetchSummaryForPark(int parkId, bool metricUnits, const int rideIds[6], Dyn
     }
     String body;
     serializeJson(bodyDoc, body);
-    const String url = apiUrl("/v1/summary");
-    return httpPostJson(url.c_str(), body, doc);
+
+    if (!workerLock()) {
+        last_http_code = HTTPC_ERROR_CONNECTION_REFUSED;
+        return false;
+    }
+    const int code = workerRequest("POST", "/v1/summary", &body, SUMMARY_BIN_ACCEPT);
+    last_http_code = code;
+    bool ok = false;
+    if (code == 200) {
+        out = ParkSummary();
+        out.metric = metricUnits;
+        if (worker_http.header("Content-Type").startsWith(SUMMARY_BIN_TYPE)) {
+            ok = readSummaryBin(worker_http, out);
+        } else {
+            DynamicJsonDocument doc(SUMMARY_DOC_BYTES);
+            ok = readJsonBody(worker_http, doc, &SUMMARY_FILTER) && summaryFromJson(doc, out);
+        }
+    }
+    workerEnd(ok);
+    workerUnlock();
+    return ok;
 }
 
-// -------------------- Drawing helpers --------------------
-void drawText(int16_t x, int16_t y, const String& s, const GFXfont* f, uint16_t color) {
-    display.setFont(f);
-    display.setTextColor(color);
-    display.setCursor(x, y);
-    display.print(s);
+// -------------------- Park summary cache --------------------
+// One /v1/summary/batch call fills every configured park. The parks rotation then renders from
+// here, without bringing up the network, until the cache is a full rotation old; all slots in a
+// rotation show data from the same fetch. Refetches are conditional on the batch ETag, so an
+// unchanged set costs a 304 and keeps the decoded entries as they are. How long a rotation step is,
+// and so when the cache expires, depends on what the set shows (see "Refresh cadence" below).
+// When a refetch fails, the rotation carries on from the entries for up to PARK_CACHE_GRACE_MS past
+// their lifetime, retrying every API_ERROR_RETRY_MS, before it shows the error.
+struct ParkCacheEntry {
+    int parkId = 0;
+    ParkSummary summary;
+};
+static ParkCacheEntry park_cache[4];
+static bool park_cache_valid = false;  // Entries are complete and match the current config
+static bool park_cache_stale = false;  // Refetch on the next tick even if within the TTL
+static unsigned long park_cache_at_ms = 0;
+static uint32_t park_cache_tick_ms = REFRESH_MS; // Rotation step the set calls for (parkCacheSetCadence())
+static uint32_t park_cache_ttl_ms = REFRESH_MS;  // Age at which the set is refetched
+static String park_cache_etag;
+
+// Force a refetch; the entries stay usable as the base for a conditional request.
+static void invalidateParkCache() {
+    park_cache_stale = true;
+}
+
+// ---- Across deep sleep ----
+// A timer wake starts with empty RAM, so with PARKPAL_DEEP_SLEEP the batch records are also kept as
+// received in RTC memory, with their ETag, cadence and fetch time (wall clock: millis() restarts
+// with every wake). The first parks refresh of a wake decodes them back, so the rotation renders
+// from the cache and refetches stay conditional, as they do without deep sleep. A set that doesn't
+// fit PARK_CACHE_RTC_BYTES isn't kept, and the next wake fetches it in full.
+const uint32_t PARK_CACHE_RTC_MAGIC = 0x4B505001u; // "PPK" + version
+const size_t PARK_CACHE_RTC_BYTES = 1536; // Four parks with typical ride names; see the RTC budget
+const uint16_t PARK_CACHE_RTC_OVERFLOW = 0xFFFF;
+
+struct ParkCacheRtc {
+    uint32_t magic;
+    uint32_t key;       // parkCacheKey() of the config the set was fetched for
+    uint32_t fetchedAt; // Unix time of the fetch or the last 304
+    uint32_t tickMs;
+    uint32_t ttlMs;
+    char etag[48];
+    uint16_t len; // Bytes used in `records`, or PARK_CACHE_RTC_OVERFLOW
+    uint8_t records[PARK_CACHE_RTC_BYTES]; // Per park, in RC.parks order: u16 length, then the "PPS" record
+};
+
+static RTC_DATA_ATTR ParkCacheRtc rtc_park_cache;
+static bool park_cache_rtc_tried = false;
+
+// FNV-1a of what a batch request asks for: units, parks and favourite rides.
+static uint32_t parkCacheKey(const RuntimeConfig& RC) {
+    uint32_t h = 2166136261u;
+    const auto add = [&h](int32_t v) {
+        for (int b = 0; b < 4; b++) h = (h ^ (uint8_t)(v >> (8 * b))) * 16777619u;
+    };
+    add(RC.metric);
+    add(RC.parks_n);
+    for (int i = 0; i < RC.parks_n; i++) {
+        add(RC.parks[i]);
+        for (int r = 0; r < 6; r++) add(RC.rideIds[i][r]);
+    }
+    return h;
 }
 
-int16_t textWidth(const String& s, const GFXfont* f) {
-    int16_t x1, y1;
-    uint16_t w, h;
-    display.setFont(f);
-    display.getTextBounds(s, 0, 0, &x1, &y1, &w, &h);
-    return w;
+// A new set is being decoded: the stored one is gone, and its records are collected afresh.
+static void parkCacheRtcBegin() {
+    if (!PARKPAL_DEEP_SLEEP) return;
+    rtc_park_cache.magic = 0;
+    rtc_park_cache.len = 0;
 }
 
-String clipToWidth(const String& s, const GFXfont* f, int16_t maxW, bool ellipsis = true) {
-    if (maxW <= 0) return "";
-    if (textWidth(s, f) <= maxW) return s;
-    if (!ellipsis) {
-        String out = s;
-        while (out.length() > 1 && textWidth(out, f) > maxW) out.remove(out.length() - 1);
-        return out;
+static void parkCacheRtcAppend(const uint8_t* record, uint16_t len) {
+    if (!PARKPAL_DEEP_SLEEP || rtc_park_cache.len == PARK_CACHE_RTC_OVERFLOW) return;
+    if (2 + (size_t)len > PARK_CACHE_RTC_BYTES - rtc_park_cache.len) {
+        rtc_park_cache.len = PARK_CACHE_RTC_OVERFLOW;
+        return;
     }
-    const String dots = "...";
-    const int16_t dotsW = textWidth(dots, f);
-    if (dotsW >= maxW) return "";
-    String out = s;
-    while (out.length() > 1 && textWidth(out + dots, f) > maxW) out.remove(out.length() - 1);
-    return out + dots;
+    uint8_t* p = rtc_park_cache.records + rtc_park_cache.len;
+    p[0] = (uint8_t)len;
+    p[1] = (uint8_t)(len >> 8);
+    memcpy(p + 2, record, len);
+    rtc_park_cache.len += 2 + len;
+}
+
+// The set in park_cache was just fetched (`complete`: its records were all appended) or confirmed
+// by a 304: keep it for the next wake.
+static void parkCacheRtcStore(const RuntimeConfig& RC, bool complete) {
+    if (!PARKPAL_DEEP_SLEEP) return;
+    const time_t now = time(nullptr);
+    ParkCacheRtc& c = rtc_park_cache;
+    if (complete) {
+        c.magic = 0;
+        if (c.len == PARK_CACHE_RTC_OVERFLOW || park_cache_etag.length() >= sizeof(c.etag)) return;
+        c.key = parkCacheKey(RC);
+        strlcpy(c.etag, park_cache_etag.c_str(), sizeof(c.etag));
+        c.magic = PARK_CACHE_RTC_MAGIC;
+    }
+    if (c.magic != PARK_CACHE_RTC_MAGIC) return;
+    if (now < 1700000000) { // No wall clock to age it by on the next wake
+        c.magic = 0;
+        return;
+    }
+    c.fetchedAt = (uint32_t)now;
+    c.tickMs = park_cache_tick_ms;
+    c.ttlMs = park_cache_ttl_ms;
+}
+
+// Once per boot: refills park_cache from RTC memory if the stored set is for RC and not too old to
+// use (see parkCacheUsableAfterError()).
+static void parkCacheRestore(const RuntimeConfig& RC) {
+    if (!PARKPAL_DEEP_SLEEP || park_cache_rtc_tried) return;
+    park_cache_rtc_tried = true;
+    const ParkCacheRtc& c = rtc_park_cache;
+    const time_t now = time(nullptr);
+    if (park_cache_valid || c.magic != PARK_CACHE_RTC_MAGIC || c.key != parkCacheKey(RC) || now < 1700000000 ||
+        (uint32_t)now < c.fetchedAt || (uint32_t)now - c.fetchedAt >= (c.ttlMs + PARK_CACHE_GRACE_MS) / 1000) {
+        return;
+    }
+    size_t pos = 0;
+    for (int i = 0; i < RC.parks_n; i++) {
+        if (pos + 2 > c.len) return;
+        const uint16_t len = summaryRd16(c.records + pos);
+        pos += 2;
+        if (len > c.len - pos) return;
+        park_cache[i].parkId = RC.parks[i];
+        if (!decodeSummaryBin(c.records + pos, len, park_cache[i].summary)) return;
+        pos += len;
+    }
+    park_cache_tick_ms = c.tickMs;
+    park_cache_ttl_ms = c.ttlMs;
+    park_cache_etag = c.etag;
+    park_cache_at_ms = millis() - ((uint32_t)now - c.fetchedAt) * 1000UL;
+    park_cache_valid = true;
+    park_cache_stale = false;
+    DBG_PRINTF("Cache: restored %d parks fetched %lu s ago\n", RC.parks_n, (unsigned long)((uint32_t)now - c.fetchedAt));
+}
+
+// Config changed (parks, favourites or units): the entries and their ETag no longer apply.
+static void discardParkCache() {
+    park_cache_valid = false;
+    park_cache_etag = "";
+    if (PARKPAL_DEEP_SLEEP) rtc_park_cache.magic = 0;
+}
+
+// Whether the entries can still be shown at `atMs` without a refetch. The slack keeps the tick a
+// full lifetime after the fetching one from just missing the expiry by the fetch's own duration.
+// It is at most a quarter of the lifetime, so even the shortest lifetime leaves the entries fresh
+// for the ticks inside it.
+static bool parkCacheFresh(unsigned long atMs = millis()) {
+    const uint32_t slack = std::min(PARK_CACHE_TTL_SLACK_MS, park_cache_ttl_ms / 4);
+    return park_cache_valid && !park_cache_stale && (uint32_t)(atMs - park_cache_at_ms) + slack < park_cache_ttl_ms;
+}
+
+// Whether the entries may stand in for a refetch that just failed.
+static bool parkCacheUsableAfterError() {
+    return park_cache_valid && (uint32_t)(millis() - park_cache_at_ms) < park_cache_ttl_ms + PARK_CACHE_GRACE_MS;
+}
+
+// ---- Refresh cadence ----
+// REFRESH_MS suits a park in the steady middle of its day. The summaries also carry the park's
+// usual hours, whether any of its rides is open right now and how fast the favourite waits are
+// moving (summary_codec.h), so every fetch picks the rotation step for the set:
+//   - REFRESH_FAST_MS from ROPE_DROP_LEAD_S before the usual opening to ROPE_DROP_WINDOW_S after
+//     it, and while waits move VOLATILITY_FAST_MIN_PER_H or faster;
+//   - REFRESH_MS while a park is open, within its hours, or when the hours aren't known;
+//   - once every park is closed and outside its hours, a single step (at most
+//     REFRESH_CLOSED_MAX_MS) to the first rope-drop window, which then refetches.
+// Live ride status overrides the hours, which are only the usual ones: a park open late stays on
+// REFRESH_MS, and one that opens late is checked every REFRESH_MS. Hours are judged in parks_tz.
+
+// Seconds from local time of day `secs` to the next `minute` after midnight (0 < result <= 1 day).
+static int32_t secsUntilMinuteOfDay(int32_t secs, int minute) {
+    const int32_t d = (int32_t)(((minute % 1440) + 1440) % 1440) * 60 - secs;
+    return d > 0 ? d : d + 86400;
+}
+
+// Rotation step one park calls for at `now`; 0 when it is closed and outside its hours, with
+// `closedS` set to the time until its rope-drop window.
+static uint32_t parkCadenceMs(const ParkSummary& s, const TzRule& tz, time_t now, int32_t& closedS) {
+    closedS = 0;
+    const bool fast = s.volatility != SUMMARY_VOLATILITY_UNKNOWN && s.volatility >= VOLATILITY_FAST_MIN_PER_H;
+    if (s.opens == SUMMARY_HOURS_UNKNOWN || s.closes == SUMMARY_HOURS_UNKNOWN) return s.operating && fast ? REFRESH_FAST_MS : REFRESH_MS;
+    int y, m, d;
+    int32_t secs = 0;
+    tzLocalDate(tz, now, y, m, d, &secs);
+    const int32_t untilRopeDrop = secsUntilMinuteOfDay(secs, s.opens - (int)(ROPE_DROP_LEAD_S / 60));
+    if (86400 - untilRopeDrop < (int32_t)(ROPE_DROP_LEAD_S + ROPE_DROP_WINDOW_S)) return REFRESH_FAST_MS;
+    if (s.operating) return fast ? REFRESH_FAST_MS : REFRESH_MS;
+    const int32_t sinceOpening = 86400 - secsUntilMinuteOfDay(secs, s.opens);
+    const int32_t hoursS = ((s.closes - s.opens + 1439) % 1440 + 1) * 60; // closes <= opens: after midnight
+    if (sinceOpening < hoursS) return REFRESH_MS;
+    closedS = untilRopeDrop;
+    return 0;
+}
+
+// Sets the rotation step and cache lifetime for the entries just fetched or revalidated.
+static void parkCacheSetCadence(const RuntimeConfig& RC) {
+    park_cache_tick_ms = REFRESH_MS;
+    const time_t now = time(nullptr);
+    if (now >= 1700000000) { // Without the clock there is no local time to judge the hours by
+        const TzRule tz = tzRuleFor(RC.parks_tz.c_str());
+        uint32_t step = 0;
+        int32_t closedS = INT32_MAX;
+        for (int i = 0; i < RC.parks_n; i++) {
+            int32_t s = 0;
+            const uint32_t ms = parkCadenceMs(park_cache[i].summary, tz, now, s);
+            if (ms) step = step ? std::min(step, ms) : ms;
+            else closedS = std::min(closedS, s);
+        }
+        if (!step) { // Every park closed: one step to the rope-drop window, then refetch
+            park_cache_tick_ms = park_cache_ttl_ms =
+                (uint32_t)std::min<int64_t>(std::max<int64_t>((int64_t)closedS * 1000, PARK_CACHE_TTL_MIN_MS), REFRESH_CLOSED_MAX_MS);
+            DBG_PRINTF("Cadence: all parks closed, next in %lu s\n", (unsigned long)(park_cache_tick_ms / 1000));
+            return;
+        }
+        park_cache_tick_ms = step;
+    }
+    park_cache_ttl_ms = (uint32_t)RC.parks_n * park_cache_tick_ms;
+    DBG_PRINTF("Cadence: every %lu s\n", (unsigned long)(park_cache_tick_ms / 1000));
+}
+
+// Streams a "PPB" batch body into park_cache, one record at a time through a single stack buffer.
+static bool readSummaryBatchBin(HTTPClient& http, const RuntimeConfig& RC) {
+    StageTimer timer(STAGE_PARSE);
+    WiFiClient& stream = http.getStream();
+    uint8_t buf[SUMMARY_BIN_MAX];
+    uint8_t count = 0;
+    if (stream.readBytes(buf, SUMMARY_BATCH_HEADER) != SUMMARY_BATCH_HEADER) return false;
+    if (!decodeSummaryBatchHeader(buf, count) || count != RC.parks_n) return false;
+    for (int i = 0; i < count; i++) {
+        uint32_t parkId = 0;
+        uint16_t len = 0;
+        if (stream.readBytes(buf, SUMMARY_BATCH_ENTRY_HEADER) != SUMMARY_BATCH_ENTRY_HEADER) return false;
+        decodeSummaryBatchEntryHeader(buf, parkId, len);
+        if ((int)parkId != RC.parks[i] || len > SUMMARY_BIN_MAX) return false;
+        if (stream.readBytes(buf, len) != len) return false;
+        park_cache[i].parkId = (int)parkId;
+        if (!decodeSummaryBin(buf, len, park_cache[i].summary)) return false;
+        parkCacheRtcAppend(buf, len);
+    }
+    return true;
 }
 
-const GFXfont* pickLargestFontThatFits(const String& s, int16_t maxW, const GFXfont* a, const GFXfont* b, const GFXfont* c) {
-    if (textWidth(s, a) <= maxW) return a;
-    if (textWidth(s, b) <= maxW) return b;
-    return c;
+bool fetchSummaryBatch(const RuntimeConfig& RC) {
+    if (API_BASE_URL.length() == 0 || RC.parks_n == 0) return false;
+    DynamicJsonDocument bodyDoc(1024);
+    bodyDoc["units"] = RC.metric ? "metric" : "imperial";
+    JsonArray parks = bodyDoc.createNestedArray("parks");
+    for (int i = 0; i < RC.parks_n; i++) {
+        JsonObject p = parks.createNestedObject();
+        p["park"] = RC.parks[i];
+        JsonArray favs = p.createNestedArray("favorite_ride_ids");
+        for (int r = 0; r < 6; r++) {
+            if (RC.rideIds[i][r] > 0) favs.add(RC.rideIds[i][r]);
+        }
+    }
+    String body;
+    serializeJson(bodyDoc, body);
+
+    if (!workerLock()) {
+        last_http_code = HTTPC_ERROR_CONNECTION_REFUSED;
+        return false;
+    }
+    const bool conditional = park_cache_valid && park_cache_etag.length() > 0;
+    const int code = workerRequest("POST", "/v1/summary/batch", &body, SUMMARY_BIN_ACCEPT,
+                                   conditional ? park_cache_etag.c_str() : nullptr);
+    last_http_code = code;
+    if (code == 304 && conditional) {
+        // Nothing changed since the cached set: no body to read, nothing to decode.
+        workerEnd(true);
+        workerUnlock();
+        DBG_PRINTLN("API: summary batch not modified");
+        park_cache_stale = false;
+        park_cache_at_ms = millis();
+        parkCacheSetCadence(RC);
+        parkCacheRtcStore(RC, false);
+        return true;
+    }
+
+    // A failed request (transport error, 5xx, 429) leaves the entries and their ETag as they were,
+    // so the next attempt can still be conditional and the entries can still be shown.
+    bool ok = false;
+    if (code == 200 && worker_http.header("Content-Type").startsWith(SUMMARY_BIN_TYPE)) {
+        // Decoding overwrites the entries in place, so they are invalid from here until it completes.
+        park_cache_valid = false;
+        park_cache_etag = "";
+        parkCacheRtcBegin();
+        ok = readSummaryBatchBin(worker_http, RC);
+        if (ok) park_cache_etag = worker_http.header("ETag");
+    }
+    workerEnd(ok);
+    workerUnlock();
+
+    if (code == 404) {
+        // Worker predates the batch endpoint: fill the cache one park at a time. Each park arrives
+        // in a scratch summary, so the entries are only given up once a replacement has been decoded.
+        static ParkSummary fetched;
+        ok = true;
+        for (int i = 0; i < RC.parks_n && ok; i++) {
+            ok = fetchSummaryForPark(RC.parks[i], RC.metric, RC.rideIds[i], fetched);
+            if (!ok) break;
+            park_cache_valid = false;
+            park_cache_etag = "";
+            parkCacheRtcBegin();
+            park_cache[i].parkId = RC.parks[i];
+            park_cache[i].summary = fetched;
+        }
+    }
+    if (ok) {
+        park_cache_valid = true;
+        park_cache_stale = false;
+        park_cache_at_ms = millis();
+        parkCacheSetCadence(RC);
+        if (code == 200) parkCacheRtcStore(RC, true);
+    }
+    return ok;
 }
 
-void drawRight(int16_t rightX, int16_t baselineY, const String& s, const GFXfont* f, uint16_t color) {
-    drawText(rightX - textWidth(s, f), baselineY, s, f, color);
+// -------------------- Rides catalog --------------------
+// Ride lists for the web UI's picker and the legacy name migration. They live in the "catalog"
+// flash partition (ride_catalog.h) and are read in place through a memory map, so they take no
+// heap. /api/rides answers from flash; parks that are missing or due for revalidation are queued
+// for a background task, so the AsyncTCP task never waits on the Worker. Revalidation is a
+// conditional GET, and a block is only rewritten when the Worker's catalog version changes.
+const uint32_t RIDES_CATALOG_TTL_MS = 12UL * 60UL * 60UL * 1000UL; // 12 hours
+const uint32_t RIDES_CATALOG_RETRY_MS = 30000; // Report a failed park for this long before refetching
+const int RIDES_CATALOG_SLOTS = 8; // Parks with fetch state tracked at once
+
+struct RidesCatalogEntry {
+    int parkId = 0;
+    unsigned long checkedAtMs = 0;
+    unsigned long failedAtMs = 0;
+    unsigned long usedAtMs = 0;
+    bool checked = false; // Revalidated against the Worker since boot
+    bool failed = false;
+    bool queued = false;
+};
+static RidesCatalogEntry rides_catalog[RIDES_CATALOG_SLOTS];
+static SemaphoreHandle_t rides_catalog_mutex = nullptr; // Guards rides_catalog and the flash map
+static QueueHandle_t rides_fetch_queue = nullptr;
+static const esp_partition_t* catalog_part = nullptr;
+static const uint8_t* catalog_map = nullptr;
+static spi_flash_mmap_handle_t catalog_map_handle = 0;
+static uint32_t catalog_seq = 0;
+static int catalog_writing = -1; // Block catalogStore() is rewriting outside the mutex; readers skip it
+
+static size_t catalogBlocks() {
+    return catalog_map ? catalog_part->size / RIDE_CATALOG_BLOCK : 0;
+}
+
+// (Re)maps the whole partition; done again after every write so reads never see stale cache lines.
+static bool catalogMap() {
+    if (catalog_map) spi_flash_munmap(catalog_map_handle);
+    catalog_map = nullptr;
+    const void* p = nullptr;
+    if (esp_partition_mmap(catalog_part, 0, catalog_part->size, SPI_FLASH_MMAP_DATA, &p, &catalog_map_handle) != ESP_OK) {
+        Serial.println("Rides: catalog mmap failed");
+        return false;
+    }
+    catalog_map = (const uint8_t*)p;
+    return true;
 }
 
-inline void thickH(int x1, int y, int x2, uint16_t c) {
-    display.drawLine(x1, y, x2, y, c);
-    display.drawLine(x1, y + 1, x2, y + 1, c);
+// Mapped block for `parkId`, or nullptr. Caller holds rides_catalog_mutex.
+static const uint8_t* catalogBlockFor(int parkId) {
+    for (size_t i = 0; i < catalogBlocks(); i++) {
+        if ((int)i == catalog_writing) continue;
+        const uint8_t* b = catalog_map + i * RIDE_CATALOG_BLOCK;
+        if (rideCatalogValid(b) && rideCatalogHeader(b)->parkId == (uint32_t)parkId) return b;
+    }
+    return nullptr;
+}
+
+// Writes `rides` as the park's block: its current block if it has one, else an empty one, else the
+// least recently written. The header goes last, so an interrupted write leaves the block empty.
+// The mutex is held only to pick the block and to publish the new mapping, not across the flash
+// erase and write; meanwhile the block is marked catalog_writing so lookups treat it as missing.
+// Only ridesFetchTask calls this, so there is never a second writer.
+static bool catalogStore(int parkId, uint32_t version, JsonArrayConst rides) {
+    const uint16_t n = (uint16_t)std::min<size_t>(rides.size(), 0xFFFF);
+    std::vector<String> norms;
+    std::vector<RideCatalogInput> in;
+    norms.reserve(n);
+    in.reserve(n);
+    for (JsonObjectConst r : rides) {
+        if (in.size() == n) break;
+        const char* name = r["name"] | "Unknown Ride";
+        norms.push_back(normalize(name));
+        const String& norm = norms.back();
+        in.push_back({(uint32_t)(r["id"] | 0UL), name, (uint16_t)strnlen(name, 0xFFFF), norm.c_str(), (uint16_t)norm.length()});
+    }
+    uint8_t* buf = (uint8_t*)malloc(RIDE_CATALOG_BLOCK);
+    if (!buf) return false;
+
+    xSemaphoreTake(rides_catalog_mutex, portMAX_DELAY);
+    int target = -1, empty = -1, oldest = -1;
+    for (int i = 0; i < (int)catalogBlocks(); i++) {
+        const uint8_t* b = catalog_map + i * RIDE_CATALOG_BLOCK;
+        if (!rideCatalogValid(b)) {
+            if (empty < 0) empty = i;
+        } else if (rideCatalogHeader(b)->parkId == (uint32_t)parkId) {
+            target = i;
+        } else if (oldest < 0 || rideCatalogHeader(b)->seq < rideCatalogHeader(catalog_map + oldest * RIDE_CATALOG_BLOCK)->seq) {
+            oldest = i;
+        }
+    }
+    const int slot = target >= 0 ? target : (empty >= 0 ? empty : oldest);
+    const uint32_t seq = catalog_seq + 1;
+    if (slot >= 0) catalog_writing = slot;
+    xSemaphoreGive(rides_catalog_mutex);
+
+    bool ok = false;
+    const size_t used = slot >= 0 ? rideCatalogBuild(buf, RIDE_CATALOG_BLOCK, parkId, version, seq, in.data(), n) : 0;
+    if (used) {
+        const size_t off = (size_t)slot * RIDE_CATALOG_BLOCK;
+        const size_t head = sizeof(RideCatalogHeader);
+        ok = esp_partition_erase_range(catalog_part, off, RIDE_CATALOG_BLOCK) == ESP_OK &&
+             (used == head || esp_partition_write(catalog_part, off + head, buf + head, used - head) == ESP_OK) &&
+             esp_partition_write(catalog_part, off, buf, head) == ESP_OK;
+    }
+    free(buf);
+
+    if (slot >= 0) {
+        xSemaphoreTake(rides_catalog_mutex, portMAX_DELAY);
+        if (ok) catalog_seq = seq;
+        if (used) catalogMap();
+        catalog_writing = -1;
+        xSemaphoreGive(rides_catalog_mutex);
+    }
+    Serial.printf("Rides: park %d catalog v%08lx, %u rides, %u bytes -> block %d %s\n", parkId, (unsigned long)version,
+                  (unsigned)n, (unsigned)used, slot, ok ? "written" : "FAILED");
+    return ok;
+}
+
+static void appendJsonString(String& out, const char* s, size_t len) {
+    out += '"';
+    for (size_t i = 0; i < len; i++) {
+        const char c = s[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((uint8_t)c < 0x20) {
+            char esc[7];
+            snprintf(esc, sizeof(esc), "\\u%04x", (unsigned)(uint8_t)c);
+            out += esc;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+// Appends the block's rides to `out` as a JSON array, in normalized-name order.
+static void catalogRidesJson(const uint8_t* block, String& out) {
+    const uint16_t n = rideCatalogHeader(block)->count;
+    const RideCatalogRecord* recs = rideCatalogRecords(block);
+    const uint16_t* byName = rideCatalogNameIndex(block);
+    const char* strings = rideCatalogStrings(block);
+    out.reserve(out.length() + rideCatalogHeader(block)->stringBytes + n * 24);
+    out += '[';
+    for (uint16_t i = 0; i < n; i++) {
+        const RideCatalogRecord& r = recs[byName[i]];
+        if (i) out += ',';
+        out += "{\"id\":";
+        out += String(r.id);
+        out += ",\"name\":";
+        appendJsonString(out, strings + r.nameOff, r.nameLen);
+        out += '}';
+    }
+    out += ']';
+}
+
+// Revalidates one park against the Worker and rewrites its block if the catalog changed. Returns
+// true when the park's block is current. Blocks on the network, so never call it from AsyncTCP.
+static bool ridesCatalogRefresh(int parkId) {
+    if (!catalog_map || WiFi.status() != WL_CONNECTED || API_BASE_URL.length() == 0) return false;
+    uint32_t version = 0;
+    bool have = false;
+    xSemaphoreTake(rides_catalog_mutex, portMAX_DELAY);
+    if (const uint8_t* b = catalogBlockFor(parkId)) {
+        version = rideCatalogHeader(b)->version;
+        have = true;
+    }
+    xSemaphoreGive(rides_catalog_mutex);
+
+    DynamicJsonDocument doc(RIDES_DOC_BYTES);
+    bool notModified = false;
+    if (!fetchRidesCatalog(parkId, have ? &version : nullptr, doc, notModified)) return false;
+    if (notModified) return true;
+    JsonArrayConst rides = doc["rides"].as<JsonArrayConst>();
+    if (rides.isNull()) return false;
+    const uint32_t latest = doc["version"] | 0UL;
+    if (have && latest != 0 && latest == version) return true;
+    return catalogStore(parkId, latest, rides);
+}
+
+// Fetch-state slot for `parkId`, reusing the least recently used idle slot on a miss. Caller holds
+// the mutex.
+static int ridesCatalogSlot(int parkId) {
+    int victim = -1;
+    for (int i = 0; i < RIDES_CATALOG_SLOTS; i++) {
+        if (rides_catalog[i].parkId == parkId) return i;
+        if (rides_catalog[i].queued) continue;
+        if (victim < 0 || rides_catalog[i].parkId == 0 ||
+            (rides_catalog[victim].parkId != 0 && rides_catalog[i].usedAtMs < rides_catalog[victim].usedAtMs)) {
+            victim = i;
+        }
+    }
+    if (victim >= 0) {
+        rides_catalog[victim] = RidesCatalogEntry();
+        rides_catalog[victim].parkId = parkId;
+    }
+    return victim;
 }
 
-inline void thickV(int x, int y1, int y2, uint16_t c) {
-    display.drawLine(x, y1, x, y2, c);
-    display.drawLine(x + 1, y1, x + 1, y2, c);
+// Appends the cached list for `parkId` to `out` when there is one, queueing a fetch when it is
+// missing or due for revalidation. Never blocks on the network.
+static RidesCatalogState ridesCatalogLookup(int parkId, String& out) {
+    if (!rides_catalog_mutex || xSemaphoreTake(rides_catalog_mutex, pdMS_TO_TICKS(100)) != pdTRUE) return RIDES_PENDING;
+    RidesCatalogState state = RIDES_PENDING;
+    const unsigned long now = millis();
+    const int slot = ridesCatalogSlot(parkId);
+    bool fetch = true;
+    if (const uint8_t* block = catalogBlockFor(parkId)) {
+        catalogRidesJson(block, out);
+        state = RIDES_READY;
+        fetch = slot >= 0 && (!rides_catalog[slot].checked || now - rides_catalog[slot].checkedAtMs >= RIDES_CATALOG_TTL_MS);
+    } else if (slot >= 0 && rides_catalog[slot].failed && now - rides_catalog[slot].failedAtMs < RIDES_CATALOG_RETRY_MS) {
+        state = RIDES_FAILED;
+        fetch = false;
+    }
+    if (slot >= 0) {
+        RidesCatalogEntry& e = rides_catalog[slot];
+        e.usedAtMs = now;
+        if (fetch && !e.queued) {
+            if (xQueueSend(rides_fetch_queue, &parkId, 0) == pdTRUE) {
+                e.queued = true;
+            } else if (state == RIDES_PENDING) {
+                // Nothing will answer a pending park that never reached the queue; report it failed
+                // so the picker stops polling, and retry after RIDES_CATALOG_RETRY_MS like a failed fetch.
+                e.failed = true;
+                e.failedAtMs = now;
+                state = RIDES_FAILED;
+            }
+        }
+    } else if (state == RIDES_PENDING) {
+        state = RIDES_FAILED; // Every fetch slot is queued for another park
+    }
+    xSemaphoreGive(rides_catalog_mutex);
+    return state;
+}
+
+static void ridesFetchTask(void*) {
+    int parkId = 0;
+    for (;;) {
+        if (xQueueReceive(rides_fetch_queue, &parkId, portMAX_DELAY) != pdTRUE) continue;
+        const bool ok = ridesCatalogRefresh(parkId);
+        DBG_PRINTF("Rides: park %d %s\n", parkId, ok ? "current" : "fetch failed");
+
+        xSemaphoreTake(rides_catalog_mutex, portMAX_DELAY);
+        for (int i = 0; i < RIDES_CATALOG_SLOTS; i++) {
+            RidesCatalogEntry& e = rides_catalog[i];
+            if (e.parkId != parkId) continue;
+            e.queued = false;
+            if (ok) {
+                e.checked = true;
+                e.checkedAtMs = millis();
+                e.failed = false;
+            } else {
+                // A block already in flash stays servable; only a park with nothing cached reports it.
+                e.failed = true;
+                e.failedAtMs = millis();
+            }
+        }
+        xSemaphoreGive(rides_catalog_mutex);
+    }
 }
 
-void drawDegreeMark(int16_t cx, int16_t cy, int16_t outerR, uint16_t color) {
-    // E-ink can render 1px outlines very faintly; use a filled ring for contrast.
-    outerR = max<int16_t>(2, outerR);
-    display.fillCircle(cx, cy, outerR, color);
-    int16_t innerR = outerR - 2;
-    if (innerR > 0) display.fillCircle(cx, cy, innerR, GxEPD_WHITE);
+void ridesCatalogInit() {
+    if (rides_catalog_mutex) return;
+    rides_catalog_mutex = xSemaphoreCreateMutex();
+    rides_fetch_queue = xQueueCreate(RIDES_CATALOG_SLOTS, sizeof(int));
+    catalog_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)RIDE_CATALOG_SUBTYPE, "catalog");
+    if (!catalog_part) {
+        Serial.println("Rides: no \"catalog\" partition (flash with the sketch's partitions.csv)");
+    } else if (catalogMap()) {
+        for (size_t i = 0; i < catalogBlocks(); i++) {
+            const uint8_t* b = catalog_map + i * RIDE_CATALOG_BLOCK;
+            if (rideCatalogValid(b)) catalog_seq = std::max(catalog_seq, rideCatalogHeader(b)->seq);
+        }
+    }
+    // TLS handshakes run on this task's stack.
+    xTaskCreate(ridesFetchTask, "rides_fetch", 12288, nullptr, tskIDLE_PRIORITY + 1, nullptr);
 }
 
+// -------------------- Frame fingerprint --------------------
+// The FrameHash (render.h) of a frame's render inputs, recorded once the frame is on the panel so
+// an identical frame is never pushed twice. Kept in RTC memory (survives deep sleep) and NVS
+// (survives reboots); a stored hash from another FRAME_HASH_SCHEMA is ignored. Bump the schema whenever a
+// renderer's layout changes for the same inputs.
+const uint32_t FRAME_HASH_SCHEMA = 1;
+const uint32_t FRAME_HASH_MAGIC = 0x46505000u | FRAME_HASH_SCHEMA; // "PPF" + schema
 
-void drawCenterLine(int16_t baselineY, const String& s, const GFXfont* f, uint16_t color) {
-    display.setFont(f);
-    int16_t x1, y1;
-    uint16_t w, h;
-    int16_t availableWidth = display.width() - 2 * BORDER_MARGIN;
-    String clipped_s = clipToWidth(s, f, availableWidth, false);
-    display.getTextBounds(clipped_s, 0, 0, &x1, &y1, &w, &h);
-    int16_t x = (display.width() - (int16_t)w) / 2;
-    display.setTextColor(color);
-    display.setCursor(x, baselineY);
-    display.print(clipped_s);
+struct FrameHashRecord {
+    uint32_t magic;
+    uint64_t hash;
+};
+
+static RTC_DATA_ATTR FrameHashRecord rtc_frame_hash;
+static uint64_t panel_frame_hash = 0; // What the panel shows; 0 = unknown
+static uint64_t nvs_frame_hash = 0;
+
+static void loadFrameHash() {
+    FrameHashRecord rec = {};
+    if (rtc_frame_hash.magic == FRAME_HASH_MAGIC) {
+        rec = rtc_frame_hash;
+    } else {
+        prefs.begin("parkpal", true);
+        if (prefs.getBytesLength("frame_hash") == sizeof rec) prefs.getBytes("frame_hash", &rec, sizeof rec);
+        prefs.end();
+        if (rec.magic != FRAME_HASH_MAGIC) rec = {};
+        nvs_frame_hash = rec.hash;
+    }
+    panel_frame_hash = rec.hash;
+}
+
+static void frameShown(uint64_t hash) {
+    panel_frame_hash = hash;
+    rtc_frame_hash = { FRAME_HASH_MAGIC, hash };
+    if (hash == nvs_frame_hash) return;
+    prefs.begin("parkpal", false);
+    prefs.putBytes("frame_hash", &rtc_frame_hash, sizeof rtc_frame_hash);
+    prefs.end();
+    nvs_frame_hash = hash;
 }
 
+// Makes the next frame push even if it matches what the panel shows (e.g. after a config save).
+static void forgetFrame() {
+    panel_frame_hash = 0;
+    rtc_frame_hash.hash = 0;
+}
 
-int16_t lineHeight(const GFXfont* f) {
-    display.setFont(f);
+static bool frameOnPanel(uint64_t hash) {
+    return hash && hash == panel_frame_hash;
+}
+
+// -------------------- Drawing --------------------
+// Layout, drawing helpers and the render functions; the host build (host/) compiles the same file
+// against a mock panel.
+#include "render.h"
+
+// -------------------- Benchmarks (/api/bench/<name>) --------------------
+// Each runs on the render task when requested; the endpoint answers 202 until its result is in.
+struct BenchState {
+    const char* name;
+    volatile bool requested;
+    volatile bool queued; // A RENDER_BENCH is waiting for the render task
+    String result;
+};
+static BenchState benches[BENCH_COUNT] = { { "text" }, { "tz" } };
+
+// ---- Text clipping benchmark (/api/bench/text) ----
+// Clips every cached ride name of the parks in parks.json to the ride-list column, once with the
+// old getTextBounds()-per-character clipper and once with clipToWidth(). It uses the display's
+// font state, hence the render task.
+const int TEXT_BENCH_PARKS[] = { 6, 7, 8, 5, 16, 17, 274, 275 };
+
+static int16_t textWidthGfx(const String& s, const GFXfont* f) {
     int16_t x1, y1;
     uint16_t w, h;
-    display.getTextBounds("Hg", 0, 0, &x1, &y1, &w, &h);
-    return (int16_t)h + 6;
-}
-
-// ====== FESTIVE ICONS =================================================
-
-IconKind pickIcon(const CountdownItem& c) {
-    // Explicit override
-    if (c.icon == "tree") return ICON_TREE;
-    if (c.icon == "reindeer") return ICON_REINDEER;
-    if (c.icon == "pumpkin") return ICON_PUMPKIN;
-    if (c.icon == "ghost") return ICON_GHOST;
-    if (c.icon == "cake") return ICON_CAKE;
-    if (c.icon == "none") return ICON_NONE;
-    // AUTO: infer by label/date
-    String labels = (c.label[0] + " " + c.label[1] + " " + c.label[2] + " " + c.label[3]);
-    String L = labels;
-    L.toLowerCase();
-    if (L.indexOf("christmas") >= 0) return ICON_TREE;
-    if (L.indexOf("halloween") >= 0) return ICON_PUMPKIN;
-    if (L.indexOf("ghost") >= 0) return ICON_GHOST;
-    if (L.indexOf("reindeer") >= 0) return ICON_REINDEER;
-    if (L.indexOf("birthday") >= 0 || c.birth_year > 0) return ICON_CAKE;
-    if (c.repeat == "yearly") {
-        if (c.month == 12 && c.day >= 20 && c.day <= 26) return ICON_TREE;
-        if (c.month == 10 && c.day >= 25 && c.day <= 31) return ICON_PUMPKIN;
-        if (c.month == 1 && c.day == 1) return ICON_REINDEER; // playful
-    }
-    return ICON_NONE;
-}
-
-// helper
-void fillTriangleI(int x0, int y0, int x1, int y1, int x2, int y2, uint16_t c) {
-    display.fillTriangle(x0, y0, x1, y1, x2, y2, c);
-}
-
-// TREE
-void drawIconTree(int cx, int cy, int s, uint16_t c) {
-    int w = s, h = s;
-    // three stacked triangles
-    fillTriangleI(cx - w * 0.35, cy - h * 0.35, cx + w * 0.35, cy - h * 0.35, cx, cy - h * 0.65, c);
-    fillTriangleI(cx - w * 0.45, cy - h * 0.10, cx + w * 0.45, cy - h * 0.10, cx, cy - h * 0.45, c);
-    fillTriangleI(cx - w * 0.55, cy + h * 0.15, cx + w * 0.55, cy + h * 0.15, cx, cy - h * 0.20, c);
-    // trunk
-    int tw = w * 0.14, th = h * 0.18;
-    display.fillRect(cx - tw / 2, cy + h * 0.15, tw, th, c);
-}
-
-// REINDEER (minimal)
-void drawIconReindeer(int cx, int cy, int s, uint16_t c, uint16_t noseC) {
-    int r = s / 4;
-    display.fillCircle(cx, cy, r, c); // head
-    // antlers
-    for (int i = 0; i < 3; i++) {
-        display.drawLine(cx - r, cy - r + i * 3, cx - r - s * 0.25, cy - r - s * 0.10 + i * 2, c);
-        display.drawLine(cx + r, cy - r + i * 3, cx + r + s * 0.25, cy - r - s * 0.10 + i * 2, c);
-    }
-    display.fillCircle(cx, cy + r * 0.9, r * 0.35, noseC); // nose
-}
-
-// PUMPKIN (three overlapping circles + stem + grooves)
-void drawIconPumpkin(int cx, int cy, int s, uint16_t c) {
-    int r = s * 0.28;
-    display.fillCircle(cx - r, cy, r, c);
-    display.fillCircle(cx, cy, r * 1.15, c);
-    display.fillCircle(cx + r, cy, r, c);
-    // stem
-    display.fillRect(cx - s * 0.05, cy - r * 1.6, s * 0.10, r * 0.9, c);
-    // grooves (thin vertical lines knocked out)
-    int bodyW = r * 3;
-    for (int i = -2; i <= 2; i++) {
-        int x = cx + i * (bodyW / 10);
-        display.drawFastVLine(x, cy - r * 1.15, r * 2.3, GxEPD_WHITE);
-    }
-}
-
-// GHOST
-void drawIconGhost(int cx, int cy, int s, uint16_t c) {
-    int r = s / 2;
-    display.fillCircle(cx, cy - r * 0.3, r * 0.7, c); // head
-    display.fillRect(cx - r * 0.7, cy - r * 0.3, r * 1.4, r * 0.9, c); // body
-    // scalloped bottom
-    for (int i = -2; i <= 2; i++) {
-        display.fillCircle(cx + i * (r * 0.5), cy + r * 0.45, r * 0.3, c);
-    }
-    // eyes (white cutouts)
-    display.fillCircle(cx - r * 0.25, cy - r * 0.25, r * 0.10, GxEPD_WHITE);
-    display.fillCircle(cx + r * 0.25, cy - r * 0.25, r * 0.10, GxEPD_WHITE);
-}
-
-// CAKE
-void drawIconCake(int cx, int cy, int s, uint16_t c, uint16_t accent) {
-    int w = s, h = s * 0.6;
-    int x = cx - w / 2, y = cy - h / 2;
-    display.fillRect(x, y + h * 0.35, w, h * 0.65, c); // base
-    display.fillRect(x, y + h * 0.25, w, h * 0.12, accent); // frosting stripe
-    // candle
-    int cw = w * 0.08, ch = h * 0.35;
-    display.fillRect(cx - cw / 2, y, cw, ch, c);
-    // flame
-    display.fillCircle(cx, y - h * 0.02, cw, accent);
-}
-
-void drawIcon(IconKind k, int x, int y, int size) {
-    if (k == ICON_NONE) return;
-    int cx = x + size / 2, cy = y + size / 2;
-    switch (k) {
-    case ICON_TREE:
-        drawIconTree(cx, cy, size, GxEPD_BLACK);
-        break;
-    case ICON_REINDEER:
-        drawIconReindeer(cx, cy, size, GxEPD_BLACK, GxEPD_RED);
-        break;
-    case ICON_PUMPKIN:
-        drawIconPumpkin(cx, cy, size, GxEPD_BLACK);
-        break;
-    case ICON_GHOST:
-        drawIconGhost(cx, cy, size, GxEPD_BLACK);
-        break;
-    case ICON_CAKE:
-        drawIconCake(cx, cy, size, GxEPD_BLACK, GxEPD_RED);
-        break;
-    default:
-        break;
-    }
+    display.setFont(f);
+    display.getTextBounds(s, 0, 0, &x1, &y1, &w, &h);
+    return w;
 }
 
-// =====================================================================
-// -------------------- Render: Parks --------------------
-String parks_lastFrameKey;
-void renderParks(const DynamicJsonDocument& doc, const int rideIds[6], const String rideLabels[6], const String& parkName, bool metricUnits, bool showTrip, const String& tripISO, const String& tripName, const String legacyFallback[6], const char* parksTz) {
-    int temp = doc["weather"]["temp"] | 0;
-    String desc = String(doc["weather"]["desc"] | "—");
-    int wcode = doc["weather"]["code"] | 0;
-    long sunrise = doc["weather"]["sunrise"] | 0L;
-    long sunset  = doc["weather"]["sunset"]  | 0L;
-    time_t now;
-    time(&now);
-    bool isNight = false;
-    if (sunrise > 0 && sunset > 0 && now > 1700000000)
-        isNight = (now < (time_t)sunrise || now > (time_t)sunset);
-    struct Row {
-        String name;
-        bool open;
-        int wait;
-    };
-    Row rows[6];
-    int count = 0;
-    JsonArrayConst ridesJson = doc["park"]["rides"].as<JsonArrayConst>();
-    for (int s = 0; s < 6; s++) {
-        int dId = rideIds[s];
-        String dLbl = rideLabels[s];
-        String legLbl = legacyFallback[s];
-        if (dId == 0 && dLbl.length() == 0 && legLbl.length() == 0) continue;
+static String clipToWidthGfx(const String& s, const GFXfont* f, int16_t maxW) {
+    if (textWidthGfx(s, f) <= maxW) return s;
+    String out = s;
+    while (out.length() > 1 && textWidthGfx(out + "...", f) > maxW) out.remove(out.length() - 1);
+    return out + "...";
+}
+
+static void runTextBenchmark() {
+    std::vector<String> names;
+    DynamicJsonDocument doc(512);
+    JsonArray missing = doc.createNestedArray("missing");
+    for (int parkId : TEXT_BENCH_PARKS) {
         bool found = false;
-        if (!ridesJson.isNull()) {
-            for (JsonVariantConst ri : ridesJson) {
-                int apiId = ri["id"] | 0;
-                String apiName = String(ri["name"] | "—");
-                bool isMatch = false;
-                if (dId > 0 && apiId == dId) isMatch = true;
-                else if (dId == 0) {
-                    String want = dLbl.length() ? dLbl : legLbl;
-                    if (normalize(apiName) == normalize(want)) isMatch = true;
-                }
-                if (isMatch) {
-                    if (apiName.indexOf("Single Rider") >= 0) continue;
-                    rows[count++] = {apiName, (bool)(ri["is_open"] | false), (int)(ri["wait_time"] | 0)};
-                    found = true;
-                    break;
+        if (rides_catalog_mutex) {
+            xSemaphoreTake(rides_catalog_mutex, portMAX_DELAY);
+            if (const uint8_t* block = catalogBlockFor(parkId)) {
+                const RideCatalogRecord* recs = rideCatalogRecords(block);
+                const char* strings = rideCatalogStrings(block);
+                for (uint16_t i = 0; i < rideCatalogHeader(block)->count; i++) {
+                    String name;
+                    name.concat(strings + recs[i].nameOff, recs[i].nameLen);
+                    names.push_back(name);
                 }
+                found = true;
             }
+            xSemaphoreGive(rides_catalog_mutex);
         }
-        if (!found) {
-            String name = dLbl.length() ? dLbl : legLbl;
-            if (name.length() > 0) rows[count++] = {name, false, -1};
-        }
-        if (count >= 6) break;
-    }
-    int days = 0;
-    bool haveTime = false;
-    if (showTrip) haveTime = daysToDateInTz(tripISO, parksTz, days);
-    String key = parkName + "|" + temp + "|" + desc + "|" + (isNight ? "N" : "D") + "|" + (showTrip ? String(days) : "-") + "|" + tripName;
-    for (int i = 0; i < count; i++) key += "|" + rows[i].name + "|" + (rows[i].open ? "1" : "0") + "|" + rows[i].wait;
-    if (key == parks_lastFrameKey) return;
-    parks_lastFrameKey = key;
-    
-    const int16_t W = display.width(), H = display.height(), M = BORDER_MARGIN, MID_X = W / 2;
-    
-    const GFXfont* titleFont = &FreeSansBold12pt7b;
-    const GFXfont* subContentFont = &FreeSans12pt7b;
-    const GFXfont* largeNumFont = &FreeSansBold24pt7b;
-    const GFXfont* largeDaysFont = &FreeSansBold18pt7b;
-
-    int16_t titleHeight = lineHeight(titleFont);
-    int16_t numHeight = lineHeight(largeNumFont);
-    int16_t contentPadding = 20;
-    
-    // Header height covers the title row + one content row in each column.
-    int16_t maxHeaderContentHeight = titleHeight + contentPadding + numHeight;
-    int16_t dynamicHeaderHeight = M + maxHeaderContentHeight + 20;
-
-    display.setFullWindow();
-    display.firstPage();
-    do {
-        display.fillScreen(GxEPD_WHITE);
-        
-        thickV(MID_X, M, dynamicHeaderHeight, GxEPD_BLACK);
-        thickH(M, dynamicHeaderHeight, W - M, GxEPD_BLACK);
-
-        int16_t currentY;
-
-        // --- Left Column: Trip Countdown ---
-        currentY = M + titleHeight;
-        const int16_t leftMaxW = (MID_X - 10) - M;
-        if (showTrip) {
-            if (haveTime) {
-                const String untilLine = String(days) + " DAYS UNTIL";
-                drawText(M, currentY, clipToWidth(untilLine, titleFont, leftMaxW, true), titleFont, GxEPD_BLACK);
-            } else {
-                drawText(M, currentY, "TRIP COUNTDOWN", titleFont, GxEPD_BLACK);
-            }
-        }
+        if (!found) missing.add(parkId);
+    }
 
-        const int16_t contentY = currentY + numHeight + contentPadding;
-        if (showTrip) {
-            if (haveTime) {
-                const String effectiveTripName = tripName.length() ? tripName : "My Trip";
-                const GFXfont* tripFont = pickLargestFontThatFits(effectiveTripName, leftMaxW, largeNumFont, largeDaysFont, titleFont);
-                drawText(M, contentY, clipToWidth(effectiveTripName, tripFont, leftMaxW, true), tripFont, GxEPD_BLACK);
-            } else {
-                drawText(M, contentY, "—", largeNumFont, GxEPD_RED);
-            }
-        } else {
-            drawText(M, currentY, "PARKPAL", titleFont, GxEPD_BLACK);
-            drawText(M, contentY, "LIVE WAIT TIMES", largeDaysFont, GxEPD_BLACK);
-        }
-
-        // --- Right Column: Weather ---
-        int16_t c2X = MID_X + 25; // Shift closer to the middle line
-        currentY = M + titleHeight;
-        drawText(c2X, currentY, "WEATHER", titleFont, GxEPD_BLACK);
-        
-        currentY = contentY;
-        // NOTE: FreeSans GFX fonts are ASCII-only; draw the degree symbol manually.
-        const String tempNum = String(temp);
-        const String unit = metricUnits ? "C" : "F";
-        drawText(c2X, currentY, tempNum, largeNumFont, GxEPD_BLACK);
-
-        // Compute bounds for positioning the degree symbol near the top-right of the number.
-        int16_t bx, by;
-        uint16_t bw, bh;
-        display.setFont(largeNumFont);
-        display.getTextBounds(tempNum, c2X, currentY, &bx, &by, &bw, &bh);
-        int16_t degreeR = (int16_t)max(3, min(7, (int)(bh / 6)));
-        int16_t degreeCx = bx + (int16_t)bw + degreeR + 3;
-        int16_t degreeCy = by + degreeR + 2;
-        drawDegreeMark(degreeCx, degreeCy, degreeR, GxEPD_BLACK);
-
-        int16_t unitX = degreeCx + degreeR + 4;
-        drawText(unitX, currentY, unit, largeNumFont, GxEPD_BLACK);
-
-        // Weather condition icon
-        int16_t iconW = WEATHER_ICON_W, iconH = WEATHER_ICON_H;
-        int16_t iconX = unitX + textWidth(unit, largeNumFont) + 14;
-        // Center the icon roughly against the temperature number, even if the icon is taller.
-        int16_t iconY = by - (int16_t)max(0, ((int)iconH - (int)bh) / 2);
-        if (iconX + iconW > (W - M)) iconX = (W - M) - iconW;
-        if (const uint8_t* bmp = weatherIconBitmap(wcode, desc, isNight)) {
-            display.drawBitmap(iconX, iconY, bmp, iconW, iconH, GxEPD_BLACK);
-        } else {
-            // Unknown: small dash centered in the icon box
-            display.fillRect(iconX + iconW / 2 - 4, iconY + iconH / 2 - 1, 8, 3, GxEPD_BLACK);
-        }
-        
-        // --- Ride List / Setup Instructions ---
-        int16_t listHeaderY = dynamicHeaderHeight + 24;
-        const int16_t listTop = listHeaderY + lineHeight(titleFont) + 5;
-        if (count == 0) {
-            const int16_t top = dynamicHeaderHeight + 40;
-            const int16_t bottom = H - M;
-
-            if (!showTrip) {
-                const GFXfont* hFont = &FreeSansBold18pt7b;
-                const GFXfont* tFont = &FreeSans12pt7b;
-                const int16_t h1 = lineHeight(hFont);
-                const int16_t h2 = lineHeight(tFont);
-                const int16_t total = h1 + 10 + (h2 * 3);
-                int16_t y = top + max<int16_t>(0, (int16_t)((bottom - top - total) / 2)) + h1;
-                drawCenterLine(y, "GET STARTED", hFont, GxEPD_BLACK);
-                y += h1 + 10;
-                drawCenterLine(y, "Open parkpal.local", tFont, GxEPD_RED);
-                y += h2;
-                drawCenterLine(y, "on the same Wi-Fi network", tFont, GxEPD_BLACK);
-                y += h2;
-                drawCenterLine(y, "to set up your trip", tFont, GxEPD_BLACK);
-            } else {
-                const GFXfont* hFont = &FreeSansBold18pt7b;
-                const GFXfont* tFont = &FreeSans12pt7b;
-                const int16_t h1 = lineHeight(hFont);
-                const int16_t h2 = lineHeight(tFont);
-                const int16_t total = h1 + 10 + (h2 * 3);
-                int16_t y = top + max<int16_t>(0, (int16_t)((bottom - top - total) / 2)) + h1;
-                drawCenterLine(y, "NO RIDES YET", hFont, GxEPD_BLACK);
-                y += h1 + 10;
-                drawCenterLine(y, "Open parkpal.local", tFont, GxEPD_RED);
-                y += h2;
-                drawCenterLine(y, "to choose a park + rides", tFont, GxEPD_BLACK);
-                y += h2;
-                drawCenterLine(y, "then hit Refresh", tFont, GxEPD_BLACK);
-            }
-        } else {
-            drawText(M, listHeaderY, parkName, titleFont, GxEPD_RED);
-            const int16_t rowH = 36; // Fits 6 rows comfortably on 7.5" 528px height with our margins
-            const int16_t waitColR = W - M;
-            int16_t y = listTop;
-            for (int i = 0; i < count; i++) {
-                if (y > (H - M)) break;
-                int16_t maxW = (W - M - M) - 140;
-                String name = clipToWidth(rows[i].name, subContentFont, maxW, true);
-                drawText(M, y, name, subContentFont, GxEPD_BLACK);
-
-                if (rows[i].wait == -1) drawRight(waitColR, y, "Unavailable", titleFont, GxEPD_RED);
-                else if (rows[i].open) drawRight(waitColR, y, String(rows[i].wait) + " min", titleFont, GxEPD_BLACK);
-                else drawRight(waitColR, y, "Closed", titleFont, GxEPD_RED);
-
-                if (i < count - 1) {
-                    thickH(M, y + 10, W - M, GxEPD_BLACK);
+    const GFXfont* f = &FreeSans12pt7b; // renderParks() ride names
+    const int16_t maxW = display.width() - 2 * BORDER_MARGIN - 140;
+    int clipped = 0, mismatches = 0;
+    const int64_t t0 = esp_timer_get_time();
+    std::vector<String> gfx;
+    gfx.reserve(names.size());
+    for (const String& n : names) gfx.push_back(clipToWidthGfx(n, f, maxW));
+    const int64_t t1 = esp_timer_get_time();
+    for (size_t i = 0; i < names.size(); i++) {
+        ClipBuffer clip;
+        const char* c = clipToWidth(names[i].c_str(), f, maxW, true, clip);
+        if (c == clip) clipped++;
+        if (gfx[i] != c) mismatches++;
+    }
+    const int64_t t2 = esp_timer_get_time();
+
+    doc["rides"] = names.size();
+    doc["clipped"] = clipped;
+    doc["max_w"] = maxW;
+    doc["getTextBounds_us"] = (uint32_t)(t1 - t0);
+    doc["cached_us"] = (uint32_t)(t2 - t1);
+    doc["mismatches"] = mismatches;
+    String& result = benches[BENCH_TEXT].result;
+    result = "";
+    serializeJson(doc, result);
+    DBG_PRINTF("Text bench: %s\n", result.c_str());
+}
+
+// ---- Time zone benchmark (/api/bench/tz) ----
+// Converts instants spread over two years, plus both sides of every DST transition, in each zone
+// the web UI offers: once the old way (setenv("TZ") + tzset() + localtime(), then restoring TZ, as
+// TzGuard did per call) and once through the compiled rule cache. Counts local times that differ.
+const char* const TZ_BENCH_ZONES[] = {
+    "EST5EDT,M3.2.0/2,M11.1.0/2", "CST6CDT,M3.2.0/2,M11.1.0/2", "MST7MDT,M3.2.0/2,M11.1.0/2", "MST7",
+    "PST8PDT,M3.2.0/2,M11.1.0/2", "AKST9AKDT,M3.2.0/2,M11.1.0/2", "HST10", "UTC0", "JST-9",
+};
+const int TZ_BENCH_SAMPLES = 240; // Evenly spaced instants per zone
+
+static void localTimeViaEnv(const char* tz, time_t t, struct tm& out) {
+    const char* cur = getenv("TZ");
+    const String prev = cur ? cur : "";
+    setenv("TZ", tz, 1);
+    tzset();
+    localtime_r(&t, &out);
+    setenv("TZ", prev.c_str(), 1);
+    tzset();
+}
+
+static void runTzBenchmark() {
+    const time_t now = time(nullptr);
+    const int64_t from = now >= 1700000000 ? (int64_t)now - 365LL * 86400 : 1735689600LL; // Else 2025-01-01
+    const int64_t span = 2LL * 365 * 86400;
+    std::vector<int64_t> instants;
+    int conversions = 0, mismatches = 0;
+    int64_t envUs = 0, compiledUs = 0;
+    for (const char* tz : TZ_BENCH_ZONES) {
+        instants.clear();
+        for (int i = 0; i < TZ_BENCH_SAMPLES; i++) instants.push_back(from + span * i / TZ_BENCH_SAMPLES);
+        TzRule rule;
+        tzRuleParse(tz, rule);
+        if (rule.hasDst) {
+            int y0, y1, m, d;
+            tzCivilFromDays((int32_t)tzFloorDiv(from, 86400), y0, m, d);
+            tzCivilFromDays((int32_t)tzFloorDiv(from + span, 86400), y1, m, d);
+            for (int y = y0; y <= y1; y++) {
+                for (const bool start : { true, false }) {
+                    const int64_t t = tzTransitionUtc(rule, y, start);
+                    for (const int64_t dt : { -3600LL, -1LL, 0LL, 3599LL }) instants.push_back(t + dt);
                 }
-                y += rowH;
             }
         }
-    } while (display.nextPage());
-}
-
-
-// -------------------- Render: Countdowns & Messages --------------------
-String countdowns_lastFrameKey;
-
-void renderMessage(const String& msg, const GFXfont* font) {
-    display.setFullWindow();
-    display.firstPage();
-    do {
-        display.fillScreen(GxEPD_WHITE);
-        drawCenterLine(display.height() / 2, msg, font, GxEPD_BLACK);
-    } while (display.nextPage());
-}
-
-void renderGetStarted() {
-    display.setFullWindow();
-    display.firstPage();
-    do {
-        display.fillScreen(GxEPD_WHITE);
-        const GFXfont* hFont = &FreeSansBold18pt7b;
-        const GFXfont* tFont = &FreeSans12pt7b;
-        const int16_t h1 = lineHeight(hFont);
-        const int16_t h2 = lineHeight(tFont);
-        const int16_t total = h1 + 10 + (h2 * 3);
-        const int16_t top = BORDER_MARGIN;
-        const int16_t bottom = display.height() - BORDER_MARGIN;
-        int16_t y = top + max<int16_t>(0, (int16_t)((bottom - top - total) / 2)) + h1;
-        drawCenterLine(y, "GET STARTED", hFont, GxEPD_BLACK);
-        y += h1 + 10;
-        drawCenterLine(y, "Open parkpal.local", tFont, GxEPD_RED);
-        y += h2;
-        drawCenterLine(y, "on the same Wi-Fi network", tFont, GxEPD_BLACK);
-        y += h2;
-        drawCenterLine(y, "to set up your trip", tFont, GxEPD_BLACK);
-    } while (display.nextPage());
-}
-
-void renderCountdowns(const CountdownItem& active, int days, int turnsAge) {
-    // Redundant frame skip
-    String key = active.id + "|" + days + "|" + turnsAge + "|" + active.icon;
-    for (int i = 0; i < 4; i++) key += "|" + active.label[i];
-    if (key == countdowns_lastFrameKey) return;
-    countdowns_lastFrameKey = key;
-    const int16_t W = display.width(), H = display.height(), M = BORDER_MARGIN;
-    const int16_t GAP_BEFORE_NUMBER = 18, GAP_BEFORE_AGE = 10;
-    int labelLines = 0;
-    for (int i = 0; i < 4; i++)
-        if (active.label[i].length()) labelLines++;
-    int16_t hLabels = labelLines * lineHeight(LABEL_FONT);
-    int16_t hNumber = lineHeight(NUM_FONT);
-    int16_t hDays = (days > 0) ? lineHeight(DAYS_FONT) : 0;
-    int16_t hAge = (days == 0 && turnsAge > 0) ? lineHeight(AGE_FONT) : 0;
-    int16_t total = hLabels + (labelLines ? GAP_BEFORE_NUMBER : 0) + (days == 0 ? (hNumber + (hAge ? (GAP_BEFORE_AGE + hAge) : 0)) : (hNumber + hDays));
-    const int16_t y0 = (H - total) / 2; // stable baseline each page
-    // ---- Icon placement (above labels if space, else top-right) ----
-    IconKind icon = pickIcon(active);
-    const int16_t PAD = BORDER_MARGIN;
-    int iconSize = 120;
-    int iconX = 0, iconY = 0;
-    int16_t topFree = y0 - PAD; // space from top to first content line
-    if (icon != ICON_NONE && topFree > 80) {
-        iconSize = min(iconSize, (int)topFree - PAD);
-        if (iconSize < 56) iconSize = 56;
-        iconX = (W - iconSize) / 2;
-        iconY = std::max<int>((int)PAD, (int)(y0 - PAD - iconSize));
-    } else if (icon != ICON_NONE) {
-        iconSize = 96;
-        iconX = W - iconSize - PAD;
-        iconY = PAD;
-    }
-    display.setFullWindow();
-    display.firstPage();
-    do {
-        display.fillScreen(GxEPD_WHITE);
-        // Draw icon first, consistent each page
-        if (icon != ICON_NONE) drawIcon(icon, iconX, iconY, iconSize);
-        int16_t y = y0;
-        // Labels
-        for (int i = 0; i < 4; i++) {
-            String line = active.label[i];
-            if (!line.length()) continue;
-            drawCenterLine(y, line, LABEL_FONT, GxEPD_BLACK);
-            y += lineHeight(LABEL_FONT);
-        }
-        if (labelLines) y += GAP_BEFORE_NUMBER;
-        if (days == 0) {
-            const char* msg = (active.repeat == "once") ? "DONE!" : "TODAY!";
-            drawCenterLine(y, msg, NUM_FONT, GxEPD_RED);
-            y += lineHeight(NUM_FONT);
-            if (hAge) {
-                y += GAP_BEFORE_AGE;
-                drawCenterLine(y, "turns " + String(turnsAge), AGE_FONT, GxEPD_BLACK);
+        std::vector<struct tm> viaEnv(instants.size());
+        const int64_t t0 = esp_timer_get_time();
+        for (size_t i = 0; i < instants.size(); i++) localTimeViaEnv(tz, (time_t)instants[i], viaEnv[i]);
+        const int64_t t1 = esp_timer_get_time();
+        for (size_t i = 0; i < instants.size(); i++) {
+            int y, m, d;
+            int32_t secs;
+            tzLocalDate(tzRuleFor(tz), instants[i], y, m, d, &secs);
+            const struct tm& e = viaEnv[i];
+            if (y != e.tm_year + 1900 || m != e.tm_mon + 1 || d != e.tm_mday ||
+                secs != e.tm_hour * 3600 + e.tm_min * 60 + e.tm_sec) {
+                mismatches++;
             }
-        } else {
-            uint16_t numColor = GxEPD_BLACK;
-            if (active.accent == "red" || (active.accent == "auto" && days <= 3)) numColor = GxEPD_RED;
-            String dayStr = String(days);
-            drawCenterLine(y, dayStr, NUM_FONT, numColor);
-            y += lineHeight(NUM_FONT);
-            drawCenterLine(y, "DAYS", DAYS_FONT, GxEPD_BLACK);
         }
-    } while (display.nextPage());
+        compiledUs += esp_timer_get_time() - t1;
+        envUs += t1 - t0;
+        conversions += (int)instants.size();
+    }
+
+    DynamicJsonDocument doc(256);
+    doc["zones"] = sizeof(TZ_BENCH_ZONES) / sizeof(TZ_BENCH_ZONES[0]);
+    doc["conversions"] = conversions;
+    doc["setenv_tzset_us"] = (uint32_t)envUs;
+    doc["compiled_us"] = (uint32_t)compiledUs;
+    doc["mismatches"] = mismatches;
+    String& result = benches[BENCH_TZ].result;
+    result = "";
+    serializeJson(doc, result);
+    DBG_PRINTF("TZ bench: %s\n", result.c_str());
+}
+
+static void runBenchmark(BenchKind kind) {
+    if (kind == BENCH_TEXT) runTextBenchmark();
+    else if (kind == BENCH_TZ) runTzBenchmark();
 }
 
 // --- FORWARD DECLARATIONS ---
+void drawSetupScreen();
 bool resolveParkSlotsToIds(int parkId, JsonDocument& cfgDoc);
 void migrateResolveIdsIfNeeded();
 
@@ -1459,12 +2610,47 @@ void startWeb() {
             req->send(ok ? 200 : 500, "text/plain", ok ? "OK" : "ERR");
         }
     });
+    // Per-stage refresh timings (microseconds) over the last few refreshes, plus heap health.
+    server.on("/api/metrics", HTTP_GET, [](AsyncWebServerRequest * req) {
+        req->send(200, "application/json", metricsJson());
+    });
+    // POST /api/render_mode?mode=full|paged -> redraws in that mode so /api/metrics can compare them.
+    server.on("/api/render_mode", HTTP_POST, [](AsyncWebServerRequest * req) {
+        const String mode = req->hasParam("mode") ? req->getParam("mode")->value() : String();
+        if (mode != "full" && mode != "paged") {
+            req->send(400, "application/json", "{\"error\":\"mode must be full or paged\"}");
+            return;
+        }
+        if (mode == "full" && !psramFound()) {
+            req->send(409, "application/json", "{\"error\":\"no PSRAM\"}");
+            return;
+        }
+        render_mode_request = mode == "full" ? 1 : 0;
+        req->send(200, "text/plain", "OK");
+    });
+    // GET /api/bench/text, /api/bench/tz -> 202 while the render task runs the benchmark, then its
+    // result; ?rerun=1 runs it again.
+    for (BenchState& b : benches) {
+        server.on((String("/api/bench/") + b.name).c_str(), HTTP_GET, [&b](AsyncWebServerRequest * req) {
+            if (b.requested || b.result.length() == 0 || req->hasParam("rerun")) {
+                if (!b.requested) b.result = "";
+                b.requested = true;
+                req->send(202, "application/json", "{\"pending\":true}");
+                return;
+            }
+            req->send(200, "application/json", b.result);
+        });
+    }
     server.on("/api/refresh", HTTP_POST, [](AsyncWebServerRequest * req) {
         refresh_now = true;
         req->send(200, "text/plain", "OK");
     });
+    // GET /api/rides?park=6 -> {"rides":[...]}
+    // GET /api/rides?parks=6,5,7,8 -> {"parks":[{"park":6,"rides":[...]}],"pending":[5],"failed":[]}
+    // Served from the rides catalog. 202 means some parks are still being fetched: poll again.
     server.on("/api/rides", HTTP_GET, [](AsyncWebServerRequest * req) {
-        if (!req->hasParam("park")) {
+        const bool multi = req->hasParam("parks");
+        if (!multi && !req->hasParam("park")) {
             req->send(400, "application/json", "{\"error\":\"missing park\"}");
             return;
         }
@@ -1472,15 +2658,50 @@ void startWeb() {
             req->send(503, "application/json", "{\"error\":\"unprovisioned\"}");
             return;
         }
-        String park = req->getParam("park")->value();
-        String url = apiUrl("/v1/rides") + "?park=" + park;
-        DynamicJsonDocument doc(24 * 1024);
-        if (httpGetJson(url, doc)) {
-            String out;
-            serializeJson(doc, out);
-            req->send(200, "application/json", out);
-        } else {
+        const String list = req->getParam(multi ? "parks" : "park")->value();
+        int ids[RIDES_CATALOG_SLOTS];
+        int n = 0;
+        for (int start = 0; start < (int)list.length() && n < RIDES_CATALOG_SLOTS;) {
+            int comma = list.indexOf(',', start);
+            if (comma < 0) comma = list.length();
+            const int id = list.substring(start, comma).toInt();
+            bool dup = false;
+            for (int i = 0; i < n; i++) dup = dup || ids[i] == id;
+            if (id > 0 && !dup) ids[n++] = id;
+            start = comma + 1;
+        }
+        if (n == 0) {
+            req->send(400, "application/json", "{\"error\":\"bad park\"}");
+            return;
+        }
+
+        String ready, pending, failed, rides;
+        int readyN = 0, pendingN = 0;
+        for (int i = 0; i < n; i++) {
+            rides = "";
+            switch (ridesCatalogLookup(ids[i], rides)) {
+                case RIDES_READY:
+                    if (readyN++) ready += ',';
+                    ready += "{\"park\":" + String(ids[i]) + ",\"rides\":" + rides + "}";
+                    break;
+                case RIDES_PENDING:
+                    if (pendingN++) pending += ',';
+                    pending += String(ids[i]);
+                    break;
+                case RIDES_FAILED:
+                    if (failed.length()) failed += ',';
+                    failed += String(ids[i]);
+                    break;
+            }
+        }
+        const int status = pendingN ? 202 : (readyN ? 200 : 502);
+        if (!multi && status == 200) {
+            req->send(200, "application/json", "{\"rides\":" + rides + "}");
+        } else if (!multi && status == 502) {
             req->send(502, "application/json", "{\"error\":\"upstream\"}");
+        } else {
+            req->send(status, "application/json",
+                      "{\"parks\":[" + ready + "],\"pending\":[" + pending + "],\"failed\":[" + failed + "]}");
         }
     });
 
@@ -1563,11 +2784,419 @@ void startWeb() {
 // -------------------- Setup / Loop --------------------
 unsigned long lastTick = 0;
 int parkIndex = 0;
-int countdownCycleIndex = 0;
-int countdownRefreshCounter = 0;
+uint32_t tick_interval_ms = REFRESH_MS; // From lastTick to the next scheduled refresh
+CountdownCycle countdown_cycle; // Cycle mode: the countdown shown and when the next one comes up
 uint8_t api_fail_streak = 0;
 unsigned long wifi_disconnected_since_ms = 0;
 unsigned long boot_press_start_ms = 0;
+static QueueHandle_t render_queue = nullptr;
+static TaskHandle_t render_task = nullptr;
+static volatile uint32_t render_posted = 0; // Commands queued (loop task only)
+static volatile uint32_t render_done = 0;   // Commands finished (render task only)
+static volatile bool render_busy = false;   // Render task is handling a command or a scheduled refresh
+
+// -------------------- Deep sleep --------------------
+// With PARKPAL_DEEP_SLEEP, the device sleeps between refreshes instead of idling in loop(). A timer
+// wake skips the web UI and boot screen, restores the rotation state below from RTC memory (the
+// frame fingerprint, the Wi-Fi fast-reconnect record and the park cache live there too), refreshes
+// once and goes back to sleep. Power-on and BOOT wakes come up in the normal web-UI mode for
+// SLEEP_UI_AWAKE_MS, extended by config saves and refreshes, before sleeping again.
+const uint32_t SLEEP_STATE_MAGIC = 0x53505004u; // "PPS" + version
+
+struct SleepState {
+    uint32_t magic;
+    int32_t parkIndex;
+    CountdownCycle countdownCycle;
+    uint32_t cycles; // Timer wakes since power-on
+    uint64_t awakeMsTotal;
+    uint32_t awakeMsLast;
+    uint32_t sleepMsLast;
+};
+
+static RTC_DATA_ATTR SleepState rtc_sleep;
+
+// Everything kept in RTC slow memory (RTC_DATA_ATTR): about 3.7 KB, nearly all of it the TLS
+// session and the park cache. The ESP32 has 8 KB, shared with the core's 512-byte ULP reserve and
+// ESP-IDF's own RTC data, so the sketch holds itself to half of it; a record that outgrows that
+// fails here rather than as a linker overflow.
+const size_t RTC_SLOW_SKETCH_BUDGET = 4096;
+static_assert(TLS_SESSION_RTC_BYTES + sizeof(rtc_wifi_fast) + sizeof(rtc_clock_synced_at) + sizeof(rtc_frame_hash) +
+                  sizeof(rtc_sleep) + sizeof(rtc_park_cache) <= RTC_SLOW_SKETCH_BUDGET,
+              "RTC slow memory records outgrew their budget");
+static bool sleep_timer_wake = false; // This boot is a timer wake: refresh once, then sleep
+static unsigned long sleep_awake_until_ms = 0;
+
+static void restoreSleepState() {
+    if (!PARKPAL_DEEP_SLEEP) return;
+    if (rtc_sleep.magic != SLEEP_STATE_MAGIC) rtc_sleep = { SLEEP_STATE_MAGIC };
+    const esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+    sleep_timer_wake = cause == ESP_SLEEP_WAKEUP_TIMER;
+    sleep_awake_until_ms = sleep_timer_wake ? 0 : millis() + SLEEP_UI_AWAKE_MS;
+    if (cause != ESP_SLEEP_WAKEUP_TIMER && cause != ESP_SLEEP_WAKEUP_EXT0) return;
+    parkIndex = rtc_sleep.parkIndex;
+    countdown_cycle = rtc_sleep.countdownCycle;
+    DBG_PRINTF("Sleep: %s wake, cycle %lu\n", sleep_timer_wake ? "timer" : "BOOT", (unsigned long)rtc_sleep.cycles);
+}
+
+// Keeps the web UI up a while longer (config saves, manual refreshes).
+static void sleepStayAwake() {
+    if (!PARKPAL_DEEP_SLEEP) return;
+    const unsigned long until = millis() + SLEEP_UI_AWAKE_MS;
+    if (sleep_awake_until_ms == 0 || (int32_t)(until - sleep_awake_until_ms) > 0) sleep_awake_until_ms = until;
+}
+
+static bool sleepDue() {
+    if (!PARKPAL_DEEP_SLEEP || in_setup_mode || pending_restart || refresh_now || lastTick == 0) return false;
+    if (render_busy || render_posted != render_done) return false;
+    if (digitalRead(BOOT_PIN) == LOW) return false;
+    return sleep_awake_until_ms == 0 || (int32_t)(millis() - sleep_awake_until_ms) >= 0;
+}
+
+// Sleeps until the next refresh is due, or until BOOT is pressed. Does not return.
+static void enterDeepSleep() {
+    const uint32_t awakeMs = millis();
+    int32_t sleepMs = (int32_t)(lastTick + tick_interval_ms - millis());
+    if (sleepMs < (int32_t)SLEEP_MIN_MS) sleepMs = SLEEP_MIN_MS;
+
+    rtc_sleep.parkIndex = parkIndex;
+    rtc_sleep.countdownCycle = countdown_cycle;
+    if (sleep_timer_wake) { // UI sessions would skew the per-cycle figures
+        rtc_sleep.cycles++;
+        rtc_sleep.awakeMsTotal += awakeMs;
+        rtc_sleep.awakeMsLast = awakeMs;
+    }
+    rtc_sleep.sleepMsLast = (uint32_t)sleepMs;
+    DBG_PRINTF("Sleep: awake %lu ms, sleeping %ld ms\n", (unsigned long)awakeMs, (long)sleepMs);
+
+    display.hibernate();
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+    esp_sleep_enable_timer_wakeup((uint64_t)sleepMs * 1000ULL);
+    rtc_gpio_pullup_en((gpio_num_t)BOOT_PIN);
+    esp_sleep_enable_ext0_wakeup((gpio_num_t)BOOT_PIN, 0);
+    Serial.flush();
+    esp_deep_sleep_start();
+}
+
+// Measured awake time per timer wake (from app start; the ~0.3 s ROM/bootloader start is not
+// counted) and the average current it implies with SLEEP_AWAKE_MA/SLEEP_ASLEEP_MA.
+void sleepStatsJson(JsonObject out) {
+    out["cycles"] = rtc_sleep.cycles;
+    out["awake_ms_last"] = rtc_sleep.awakeMsLast;
+    out["sleep_ms_last"] = rtc_sleep.sleepMsLast;
+    if (!rtc_sleep.cycles) return;
+    const float awakeAvg = (float)rtc_sleep.awakeMsTotal / rtc_sleep.cycles;
+    const float period = awakeAvg + (rtc_sleep.sleepMsLast ? rtc_sleep.sleepMsLast : REFRESH_MS);
+    out["awake_ms_avg"] = (uint32_t)awakeAvg;
+    out["duty_pct"] = 100.0f * awakeAvg / period;
+    out["est_avg_ma"] = (SLEEP_AWAKE_MA * awakeAvg + SLEEP_ASLEEP_MA * (period - awakeAvg)) / period;
+}
+
+// -------------------- Tasks --------------------
+// A refresh can spend tens of seconds waiting on Wi-Fi, the Worker and the panel's BUSY line, so
+// it runs off the Arduino loop. Three tasks, connected by queues:
+//   - control: loop() on the Arduino core. BOOT gestures, the Wi-Fi AP fallback, setup-mode DNS,
+//     and turning web UI requests into render commands. It only polls and posts, never waits.
+//   - render: owns the panel, the display list and the config snapshot. Runs the parks rotation or
+//     countdown when due (see runRefresh()) and on commands, and asks the network task for summaries.
+//   - network: on the Wi-Fi core. Reconnects and fetches for the render task, and keeps
+//     reconnecting in the background between refreshes.
+// A command that arrives during a refresh runs as soon as that refresh ends.
+const int RENDER_QUEUE_LEN = 8;
+const uint32_t NET_IDLE_POLL_MS = 1000;
+const BaseType_t NET_TASK_CORE = 0; // PRO_CPU, with the Wi-Fi and lwIP tasks
+const BaseType_t RENDER_TASK_CORE = portNUM_PROCESSORS > 1 ? 1 : 0;
+
+struct NetResult {
+    bool wifiOk;
+    bool ok;
+};
+
+static QueueHandle_t net_queue = nullptr;       // const RuntimeConfig* whose parks to fetch
+static QueueHandle_t net_reply_queue = nullptr; // NetResult
+static TaskHandle_t net_task = nullptr;
+
+// Queues a render command (loop task only); false when the queue is full.
+static bool postRender(RenderCmdKind kind, int8_t arg = 0, const char* text = nullptr) {
+    if (!render_queue) return false;
+    const RenderCmd cmd = { kind, arg, text };
+    render_posted++;
+    if (xQueueSend(render_queue, &cmd, 0) == pdTRUE) return true;
+    render_posted--;
+    return false;
+}
+
+static void netTask(void*) {
+    const RuntimeConfig* cfg = nullptr;
+    for (;;) {
+        if (xQueueReceive(net_queue, &cfg, pdMS_TO_TICKS(NET_IDLE_POLL_MS)) != pdTRUE) {
+            // Opportunistic reconnect between refreshes (not on a timer wake, where the refresh
+            // connects only if it needs to).
+            if (!in_setup_mode && !sleep_timer_wake && WiFi.status() != WL_CONNECTED) ensureWiFiConnected(0);
+            continue;
+        }
+        NetResult res = {};
+        {
+            StageTimer timer(STAGE_WIFI);
+            res.wifiOk = ensureWiFiConnected(WIFI_CONNECT_TIMEOUT_MS);
+        }
+        res.ok = res.wifiOk && fetchSummaryBatch(*cfg);
+        if (!res.ok && res.wifiOk) {
+            api_fail_streak++;
+            if (api_fail_streak >= API_FAIL_STREAK_WIFI_RESET) {
+                api_fail_streak = 0;
+                WiFi.disconnect(false);
+                delay(250);
+                connectWiFi();
+                kickNTP();
+                if (WiFi.status() == WL_CONNECTED) {
+                    res.ok = fetchSummaryBatch(*cfg);
+                }
+            }
+        } else if (res.ok) {
+            api_fail_streak = 0;
+        }
+        xQueueSend(net_reply_queue, &res, portMAX_DELAY);
+    }
+}
+
+// ---- Summary prefetch ----
+// The batch cache serves a whole rotation, so every parks_n-th tick used to wait for the network.
+// After a refresh, if the cache will have expired by the next tick, the network task refetches it
+// in the background SUMMARY_PREFETCH_LEAD_MS before that tick (close enough that the data isn't
+// a whole interval old when shown), and the tick only renders. The render task collects the
+// result before it next touches the cache or the config snapshot the fetch reads. Not with deep
+// sleep: the cache doesn't survive it.
+static bool net_prefetch_pending = false;  // Render task only
+static unsigned long prefetch_at_ms = 0;   // Render task only; 0 when none is scheduled
+
+static void netPrefetchCollect() {
+    if (!net_prefetch_pending) return;
+    NetResult res = {};
+    xQueueReceive(net_reply_queue, &res, portMAX_DELAY);
+    net_prefetch_pending = false;
+    DBG_PRINTF("Prefetch: %s\n", res.ok ? "ok" : "failed");
+}
+
+static void netPrefetchStart() {
+    prefetch_at_ms = 0;
+    const RuntimeConfig* cfg = currentConfig();
+    if (net_prefetch_pending || !cfg || cfg->mode != "parks" || cfg->parks_n == 0) return;
+    if (parkCacheFresh(lastTick + tick_interval_ms)) return;
+    xQueueSend(net_queue, &cfg, portMAX_DELAY);
+    net_prefetch_pending = true;
+}
+
+// After a successful parks refresh, plans the prefetch for the next tick if it would have to fetch.
+static void schedulePrefetch() {
+    prefetch_at_ms = 0;
+    if (PARKPAL_DEEP_SLEEP) return;
+    const RuntimeConfig* cfg = currentConfig();
+    if (!cfg || cfg->mode != "parks" || cfg->parks_n == 0) return;
+    const unsigned long tickAt = lastTick + tick_interval_ms;
+    if (!park_cache_valid || park_cache_stale || parkCacheFresh(tickAt)) return;
+    prefetch_at_ms = tickAt - SUMMARY_PREFETCH_LEAD_MS;
+    if (!prefetch_at_ms) prefetch_at_ms = 1;
+}
+
+// Fetches the summaries for RC on the network task, waiting for the result.
+static bool netFetchSummaries(const RuntimeConfig& RC, bool& wifiOk) {
+    const RuntimeConfig* cfg = &RC;
+    NetResult res = {};
+    xQueueSend(net_queue, &cfg, portMAX_DELAY);
+    xQueueReceive(net_reply_queue, &res, portMAX_DELAY);
+    wifiOk = res.wifiOk;
+    return res.ok;
+}
+
+// A countdown frame changes only at local midnight in countdowns_tz (the day count) or when the
+// cycle steps, so the next tick is the earlier of the two rather than REFRESH_MS later; with deep
+// sleep that is about one wake a day. It lands a little after the instant, so the new date is in
+// effect even if the wake comes early. countdown_cycle is kept in RTC memory, so the wake scheduled
+// for a step still has the step instant and takes it.
+static void scheduleCountdownTick(const char* tz) {
+    const time_t now = time(nullptr);
+    const int64_t next = countdownCycleNextChange(countdown_cycle, tzNextLocalMidnight(tzRuleFor(tz), now));
+    tick_interval_ms = (uint32_t)std::max<int64_t>((next - now) * 1000 + COUNTDOWN_TICK_SLACK_MS, 1000);
+}
+
+// One refresh: the next park in the rotation, or the active countdown. `now` (a Refresh from the
+// web UI, a config save) shows new data instead of the park cache.
+static void runRefresh(bool now) {
+    lastTick = millis();
+    tick_interval_ms = REFRESH_MS;
+    RefreshMetricsScope metrics;
+    netPrefetchCollect();
+    if (now) invalidateParkCache();
+    const RuntimeConfig* cfg = currentConfig();
+    if (!cfg) {
+        renderMessage("Config Error", MSG_FONT);
+        return;
+    }
+    const RuntimeConfig& RC = *cfg;
+    // Compared with the mode kept in countdown_cycle (RTC memory across deep sleep), so a wake
+    // continues the cycle instead of starting it over.
+    countdownCycleEnterMode(countdown_cycle, RC.mode == "parks" ? CYCLE_MODE_PARKS : CYCLE_MODE_COUNTDOWN);
+    wifiSetPowerSave(RC.mode != "parks");
+    if (RC.mode == "parks") {
+        if (RC.parks_n == 0) {
+            renderGetStarted();
+            return;
+        }
+        int idx = parkIndex % RC.parks_n;
+        parkIndex = (parkIndex + 1) % RC.parks_n;
+        const int parkId = RC.parks[idx];
+        char nameBuf[24];
+        const char* parkName = parkNameForId(parkId, nameBuf, sizeof nameBuf);
+        bool wifiOk = true;
+        parkCacheRestore(RC);
+        bool ok = parkCacheFresh();
+        bool fromStaleCache = false;
+        if (!ok) ok = netFetchSummaries(RC, wifiOk);
+        if (!ok && parkCacheUsableAfterError()) {
+            DBG_PRINTLN("API: refetch failed, showing cached parks");
+            ok = fromStaleCache = true;
+        }
+
+        if (ok) {
+            tick_interval_ms = fromStaleCache ? std::min(park_cache_tick_ms, API_ERROR_RETRY_MS) : park_cache_tick_ms;
+            char tripBuf[24];
+            const char* tripName = RC.trip_name.c_str();
+            if (!*tripName) tripName = inferTripNameFromParks(RC.resort.c_str(), RC.parks, RC.parks_n, tripBuf, sizeof tripBuf);
+            renderParks(park_cache[idx].summary, RC.rideIds[idx], RC.rideLabels[idx], parkName, RC.metric, RC.trip_enabled,
+                        RC.trip_date.c_str(), tripName, RC.legacyNames[idx], RC.parks_tz.c_str());
+        } else {
+            if (wifiOk) {
+                // Retry sooner than the normal refresh interval.
+                tick_interval_ms = API_ERROR_RETRY_MS;
+                char msg[24] = "API Error";
+                if (last_http_code > 0) snprintf(msg, sizeof msg, "API HTTP %d", last_http_code);
+                renderMessage(msg, MSG_FONT);
+            } else {
+                char msg[64] = "WiFi offline";
+                if (last_wifi_disconnect_reason)
+                    snprintf(msg, sizeof msg, "WiFi offline (%s)", wifiReasonToStr(last_wifi_disconnect_reason));
+                renderMessage(msg, MSG_FONT);
+            }
+        }
+    } else { // Countdown mode
+        if (RC.countdowns_n == 0) {
+            renderMessage("No Countdowns Configured", MSG_FONT);
+            return;
+        }
+        // Points into the config snapshot; items are picked by position, never copied.
+        const CountdownItem* active = &RC.countdowns[0];
+        if (RC.countdownSettings.show_mode == "single") {
+            const char* want = RC.countdownSettings.primary_id.empty() ? RC.countdowns[0].id.c_str()
+                                                                       : RC.countdownSettings.primary_id.c_str();
+            for (int i = 0; i < RC.countdowns_n; i++) {
+                if (RC.countdowns[i].id == want) {
+                    active = &RC.countdowns[i];
+                    break;
+                }
+            }
+        } else { // cycle
+            int cycleN = 0;
+            for (int i = 0; i < RC.countdowns_n; i++)
+                if (RC.countdowns[i].include_in_cycle) cycleN++;
+            if (cycleN == 0) {
+                renderMessage("No Countdowns in Cycle", MSG_FONT);
+                return;
+            }
+            // The cycle steps every cycle_every_n_refreshes * REFRESH_MS of clock time; the ticks in
+            // between are skipped (see scheduleCountdownTick()).
+            const time_t now = time(nullptr);
+            const time_t period = (time_t)std::max(RC.countdownSettings.cycle_every_n_refreshes, 1) * (REFRESH_MS / 1000);
+            int pick = now >= 1700000000 ? countdownCycleStep(countdown_cycle, now, period, cycleN)
+                                         : countdown_cycle.index % cycleN;
+            for (int i = 0; i < RC.countdowns_n; i++) {
+                if (RC.countdowns[i].include_in_cycle && pick-- == 0) {
+                    active = &RC.countdowns[i];
+                    break;
+                }
+            }
+        }
+        int days, turnsAge;
+        computeDaysToEvent(*active, RC.countdowns_tz.c_str(), days, turnsAge);
+        if (days == -2) { // NTP not ready
+            renderMessage("Syncing Time...", MSG_FONT);
+        } else {
+            renderCountdowns(*active, days, turnsAge);
+            scheduleCountdownTick(RC.countdowns_tz.c_str());
+        }
+    }
+}
+
+static void runRenderCmd(const RenderCmd& cmd) {
+    switch (cmd.kind) {
+    case RENDER_MESSAGE:
+        renderMessage(cmd.text, MSG_FONT);
+        return;
+    case RENDER_SETUP_SCREEN:
+        drawSetupScreen();
+        return;
+    case RENDER_BENCH:
+        runBenchmark((BenchKind)cmd.arg);
+        benches[cmd.arg].requested = false;
+        benches[cmd.arg].queued = false;
+        return;
+    case RENDER_CONFIG_CHANGED:
+        netPrefetchCollect();
+        discardParkCache();
+        forgetFrame();
+        countdown_cycle.rotateAt = 0;
+        break;
+    case RENDER_SET_MODE: // Redraw so the next sample shows the new mode
+        if (cmd.arg) display.enableFullFrame();
+        else display.disableFullFrame();
+        forgetFrame();
+        break;
+    case RENDER_TICK:
+    case RENDER_REFRESH_NOW:
+        break;
+    }
+    if (in_setup_mode) return;
+    // Refresh presses that queued up behind this command are served by this refresh.
+    RenderCmd next;
+    while (xQueuePeek(render_queue, &next, 0) == pdTRUE && next.kind == RENDER_REFRESH_NOW &&
+           xQueueReceive(render_queue, &next, 0) == pdTRUE) {
+        render_done++;
+    }
+    runRefresh(cmd.kind != RENDER_TICK);
+    schedulePrefetch();
+}
+
+static void renderTask(void*) {
+    for (;;) {
+        TickType_t wait = portMAX_DELAY; // Setup mode draws only on request
+        if (!in_setup_mode) {
+            int32_t dueMs = lastTick ? (int32_t)(lastTick + tick_interval_ms - millis()) : 0; // 0: first refresh after boot
+            if (prefetch_at_ms) dueMs = std::min(dueMs, (int32_t)(prefetch_at_ms - millis()));
+            wait = dueMs > 0 ? pdMS_TO_TICKS(dueMs) : 0;
+        }
+        RenderCmd cmd = { RENDER_TICK, 0, nullptr };
+        const bool posted = xQueueReceive(render_queue, &cmd, wait) == pdTRUE;
+        if (!posted && prefetch_at_ms && (int32_t)(lastTick + tick_interval_ms - millis()) > 0) {
+            netPrefetchStart();
+            continue;
+        }
+        render_busy = true;
+        runRenderCmd(cmd);
+        render_busy = false;
+        if (posted) render_done++;
+    }
+}
+
+// Called at the end of setup(); from then on only the render task touches the panel.
+static void startTasks() {
+    render_queue = xQueueCreate(RENDER_QUEUE_LEN, sizeof(RenderCmd));
+    net_queue = xQueueCreate(1, sizeof(const RuntimeConfig*));
+    net_reply_queue = xQueueCreate(1, sizeof(NetResult));
+    // TLS handshakes run on the network task's stack.
+    xTaskCreatePinnedToCore(netTask, "net", 12288, nullptr, tskIDLE_PRIORITY + 1, &net_task, NET_TASK_CORE);
+    metrics_net_task = net_task;
+    xTaskCreatePinnedToCore(renderTask, "render", 12288, nullptr, tskIDLE_PRIORITY + 1, &render_task, RENDER_TASK_CORE);
+}
 
 static String randomAlphaNum(size_t n) {
     const char* alphabet = "ABCDEFGHJKLMNPQRSTUVWXYZ23456789abcdefghjkmnpqrstuvwxyz";
@@ -1610,35 +3239,33 @@ static void startSetupMode(bool wipe) {
 
     dnsServer.start(53, "*", apIP);
 
-    display.setFullWindow();
-    display.firstPage();
-    do {
-        display.fillScreen(GxEPD_WHITE);
-        drawText(BORDER_MARGIN, BORDER_MARGIN + 40, "PARKPAL SETUP", &FreeSansBold18pt7b, GxEPD_BLACK);
-        int y = BORDER_MARGIN + 100;
-        drawText(BORDER_MARGIN, y, "Wi-Fi:", &FreeSans12pt7b, GxEPD_BLACK);
-        y += 30;
-        drawText(BORDER_MARGIN, y, setup_ap_ssid, &FreeSansBold12pt7b, GxEPD_BLACK);
-        y += 40;
-        drawText(BORDER_MARGIN, y, "Password:", &FreeSans12pt7b, GxEPD_BLACK);
-        y += 30;
-        drawText(BORDER_MARGIN, y, setup_ap_pass.length() ? setup_ap_pass : "(none)", &FreeSansBold12pt7b, GxEPD_BLACK);
-        y += 50;
-        drawText(BORDER_MARGIN, y, "Open: http://192.168.4.1", &FreeSans12pt7b, GxEPD_BLACK);
-    } while (display.nextPage());
+    if (render_task) postRender(RENDER_SETUP_SCREEN);
+    else drawSetupScreen(); // From setup(), before the tasks start
+}
+
+void drawSetupScreen() {
+    renderSetupScreen(setup_ap_ssid.c_str(), setup_ap_pass.c_str());
 }
 
 void setup() {
     Serial.begin(115200);
     WiFi.onEvent(onWiFiEvent);
+    sntp_set_time_sync_notification_cb(onClockSync);
     pinMode(BOOT_PIN, INPUT_PULLUP);
     SPI.begin(EPD_SCK, -1, EPD_MOSI, EPD_CS);
     // GxEPD2 prints "Busy Timeout!" diagnostics when a serial baud is provided.
     // Keep Serial output quiet for normal users; enable diagnostics only in debug builds.
     display.init(PARKPAL_DEBUG ? 115200 : 0, true, 2, false);
     display.setRotation(4);
+    display.epd2.setBusyCallback(epdBusyCallback);
+    loadFrameHash();
+    restoreSleepState();
+    if (PARKPAL_FULL_FRAME && display.enableFullFrame()) DBG_PRINTLN("Display: full-frame (PSRAM)");
+    else DBG_PRINTLN("Display: paged");
 
     loadProvisioningKeys();
+    workerConnInit();
+    ridesCatalogInit();
     Serial.println();
     Serial.println("=== ParkPal boot ===");
     Serial.printf("Provisioned: %s\n", isProvisioned() ? "yes" : "no");
@@ -1653,6 +3280,16 @@ void setup() {
         return;
     }
 
+    if (sleep_timer_wake) {
+        // Straight to the refresh: it connects Wi-Fi only if it needs data. The clock kept running
+        // through deep sleep, but drifts with the RTC oscillator, so it is resynced now and then.
+        const time_t now = time(nullptr);
+        const bool resync = now < 1700000000 || (uint32_t)(now - rtc_clock_synced_at) >= SLEEP_CLOCK_RESYNC_S;
+        if (resync && ensureWiFiConnected(WIFI_CONNECT_TIMEOUT_MS)) resyncClock(NTP_SYNC_TIMEOUT_MS);
+        startTasks();
+        return;
+    }
+
     connectWiFi();
     DBG_PRINTF("WiFi status after connect: %d\n", (int)WiFi.status());
     if (WiFi.status() != WL_CONNECTED && just_provisioned) {
@@ -1663,6 +3300,7 @@ void setup() {
     }
     if (WiFi.status() == WL_CONNECTED) {
         initNTP();
+        wifiFastSave(); // Stamps a lease obtained before the clock was set
     } else {
         DBG_PRINTLN("WiFi not connected; skipping NTP sync.");
     }
@@ -1679,15 +3317,8 @@ void setup() {
     if (MDNS.begin("parkpal")) DBG_PRINTLN("mDNS started: http://parkpal.local/");
     IPAddress ip = WiFi.localIP();
     String ipStr = ip.toString();
-    display.setFullWindow();
-    display.firstPage();
-    do {
-        display.fillScreen(GxEPD_WHITE);
-        drawText(BORDER_MARGIN, BORDER_MARGIN + 40, "ParkPal", &FreeSansBold18pt7b, GxEPD_BLACK);
-        drawText(BORDER_MARGIN, BORDER_MARGIN + 80, WiFi.isConnected() ? "WiFi connected" : "WiFi offline", &FreeSans12pt7b, WiFi.isConnected() ? GxEPD_BLACK : GxEPD_RED);
-        drawText(BORDER_MARGIN, BORDER_MARGIN + 110, "Open: parkpal.local", &FreeSans12pt7b, GxEPD_BLACK);
-        drawText(BORDER_MARGIN, BORDER_MARGIN + 140, "IP: " + ipStr, &FreeSans12pt7b, GxEPD_BLACK);
-    } while (display.nextPage());
+    renderBootScreen(WiFi.isConnected(), ipStr.c_str());
+    startTasks();
 }
 
 void loop() {
@@ -1708,7 +3339,7 @@ void loop() {
     if (bootPressed) {
         if (boot_press_start_ms == 0) boot_press_start_ms = nowMs;
         if ((uint32_t)(nowMs - boot_press_start_ms) >= FACTORY_RESET_HOLD_MS) {
-            renderMessage("Factory Reset...", MSG_FONT);
+            postRender(RENDER_MESSAGE, 0, "Factory Reset...");
             startSetupMode(true);
             boot_press_start_ms = 0;
             return;
@@ -1721,7 +3352,7 @@ void loop() {
     if (WiFi.status() != WL_CONNECTED) {
         if (wifi_disconnected_since_ms == 0) wifi_disconnected_since_ms = nowMs;
         if ((uint32_t)(nowMs - wifi_disconnected_since_ms) >= WIFI_AP_FALLBACK_AFTER_MS) {
-            renderMessage("WiFi Failed - Setup", MSG_FONT);
+            postRender(RENDER_MESSAGE, 0, "WiFi Failed - Setup");
             startSetupMode(false);
             wifi_disconnected_since_ms = 0;
             return;
@@ -1730,129 +3361,29 @@ void loop() {
         wifi_disconnected_since_ms = 0;
     }
 
-    // Config save should trigger an immediate refresh, even if the caller doesn't hit /api/refresh.
+    // Requests from the web UI go to the render task; a full queue leaves the flag set for the
+    // next pass. Config save should trigger an immediate refresh, even if the caller doesn't hit
+    // /api/refresh.
     if (config_changed) {
         config_changed = false;
-        parks_lastFrameKey = "";
-        countdowns_lastFrameKey = "";
-        refresh_now = true;
+        sleepStayAwake();
+        if (!postRender(RENDER_CONFIG_CHANGED)) config_changed = true;
     }
-
-    // Opportunistic reconnect in the background even between refreshes.
-    if (WiFi.status() != WL_CONNECTED) ensureWiFiConnected(0);
-
-    if (refresh_now || millis() - lastTick >= REFRESH_MS || lastTick == 0) {
-        lastTick = millis();
+    if (refresh_now) {
         refresh_now = false;
-        RuntimeConfig RC;
-        if (!parseConfig(RC)) {
-            renderMessage("Config Error", MSG_FONT);
-            return;
-        }
-        static String lastMode = "";
-        if (RC.mode != lastMode) {
-            parks_lastFrameKey = "";
-            countdowns_lastFrameKey = "";
-            lastMode = RC.mode;
-            countdownCycleIndex = 0;
-            countdownRefreshCounter = 0;
-        }
-        if (RC.mode == "parks") {
-            if (RC.parks_n == 0) {
-                renderGetStarted();
-                return;
-            }
-            int idx = parkIndex % RC.parks_n;
-            parkIndex = (parkIndex + 1) % RC.parks_n;
-            const int parkId = RC.parks[idx];
-            String parkName = parkNameForId(parkId);
-            int ids[6];
-            String labels[6];
-            String legacy[6];
-            for (int i = 0; i < 6; i++) {
-                ids[i] = RC.rideIds[idx][i];
-                labels[i] = RC.rideLabels[idx][i];
-                legacy[i] = RC.legacyNames[idx][i];
-            }
-            DynamicJsonDocument doc(16 * 1024);
-            const bool wifiOk = ensureWiFiConnected(WIFI_CONNECT_TIMEOUT_MS);
-            bool ok = wifiOk && fetchSummaryForPark(parkId, RC.metric, ids, doc);
-            if (!ok && wifiOk) {
-                api_fail_streak++;
-                if (api_fail_streak >= API_FAIL_STREAK_WIFI_RESET) {
-                    api_fail_streak = 0;
-                    WiFi.disconnect(false);
-                    delay(250);
-                    connectWiFi();
-                    kickNTP();
-                    if (WiFi.status() == WL_CONNECTED) {
-                        ok = fetchSummaryForPark(parkId, RC.metric, ids, doc);
-                    }
-                }
-            } else if (ok) {
-                api_fail_streak = 0;
-            }
-
-            if (ok) {
-                String tripName = RC.trip_name;
-                if (!tripName.length()) tripName = inferTripNameFromParks(RC.resort, RC.parks, RC.parks_n);
-                renderParks(doc, ids, labels, parkName, RC.metric, RC.trip_enabled, RC.trip_date, tripName, legacy, RC.parks_tz.c_str());
-            } else {
-                if (wifiOk) {
-                    // Retry sooner than the normal refresh interval.
-                    lastTick = millis() - (REFRESH_MS - API_ERROR_RETRY_MS);
-                    renderMessage(last_http_code > 0 ? ("API HTTP " + String(last_http_code)) : "API Error", MSG_FONT);
-                } else {
-                    String msg = "WiFi offline";
-                    if (last_wifi_disconnect_reason) {
-                        msg += " (";
-                        msg += wifiReasonToStr(last_wifi_disconnect_reason);
-                        msg += ")";
-                    }
-                    renderMessage(msg, MSG_FONT);
-                }
-            }
-        } else { // Countdown mode
-            CountdownItem activeItem;
-            bool itemAvailable = false;
-            if (RC.countdowns.empty()) {
-                renderMessage("No Countdowns Configured", MSG_FONT);
-                return;
-            }
-            if (RC.countdownSettings.show_mode == "single") {
-                String want = RC.countdownSettings.primary_id;
-                if (want.length() == 0) want = RC.countdowns[0].id;
-                for (const auto& item : RC.countdowns) {
-                    if (item.id == want) {
-                        activeItem = item;
-                        itemAvailable = true;
-                        break;
-                    }
-                }
-                if (!itemAvailable) activeItem = RC.countdowns[0];
-            } else { // cycle
-                std::vector<CountdownItem> cycleItems;
-                for (const auto& item : RC.countdowns)
-                    if (item.include_in_cycle) cycleItems.push_back(item);
-                if (cycleItems.empty()) {
-                    renderMessage("No Countdowns in Cycle", MSG_FONT);
-                    return;
-                }
-                if (++countdownRefreshCounter >= RC.countdownSettings.cycle_every_n_refreshes) {
-                    countdownRefreshCounter = 0;
-                    countdownCycleIndex = (countdownCycleIndex + 1) % cycleItems.size();
-                }
-                activeItem = cycleItems[cycleItems.size() > 0 ? countdownCycleIndex % cycleItems.size() : 0];
-            }
-            int days, turnsAge;
-            computeDaysToEvent(activeItem, RC.countdowns_tz.c_str(), days, turnsAge);
-            if (days == -2) { // NTP not ready
-                renderMessage("Syncing Time...", MSG_FONT);
-            } else {
-                renderCountdowns(activeItem, days, turnsAge);
-            }
-        }
+        sleepStayAwake();
+        if (!postRender(RENDER_REFRESH_NOW)) refresh_now = true;
     }
+    const int8_t mode = render_mode_request;
+    if (mode >= 0 && postRender(RENDER_SET_MODE, mode)) render_mode_request = -1;
+    for (int i = 0; i < BENCH_COUNT; i++) {
+        BenchState& b = benches[i];
+        if (!b.requested || b.queued) continue;
+        b.queued = true;
+        if (!postRender(RENDER_BENCH, i)) b.queued = false;
+    }
+
+    if (sleepDue()) enterDeepSleep();
 
     // Yield to keep WiFi/webserver healthy.
     delay(10);
@@ -1886,14 +3417,16 @@ bool resolveParkSlotsToIds(int parkId, JsonDocument& cfgDoc) {
     JsonArray leg = cfgDoc["rides_by_park"][String(parkId)].as<JsonArray>();
     while (ids.size() < 6) ids.add(0);
     while (labs.size() < 6) labs.add("");
-    DynamicJsonDocument doc(24 * 1024);
-    if (API_BASE_URL.length() == 0) return false;
-    String url = apiUrl("/v1/rides") + "?park=" + String(parkId);
-    if (!httpGetJson(url, doc)) return false;
-    JsonArray canon = doc["rides"].as<JsonArray>();
-    if (canon.isNull()) return false;
+    if (API_BASE_URL.length() == 0 || !rides_catalog_mutex) return false;
+    xSemaphoreTake(rides_catalog_mutex, portMAX_DELAY);
+    const bool cached = catalogBlockFor(parkId) != nullptr;
+    xSemaphoreGive(rides_catalog_mutex);
+    if (!cached && !ridesCatalogRefresh(parkId)) return false;
+
     bool changed = false;
-    for (int i = 0; i < 6; i++) {
+    xSemaphoreTake(rides_catalog_mutex, portMAX_DELAY);
+    const uint8_t* block = catalogBlockFor(parkId);
+    for (int i = 0; i < 6 && block; i++) {
         int curId = (int)ids[i];
         String label = String(labs[i] | "");
         String legacy = leg.isNull() ? String("") : String(leg[i] | "");
@@ -1901,15 +3434,15 @@ bool resolveParkSlotsToIds(int parkId, JsonDocument& cfgDoc) {
         String want = label.length() ? label : legacy;
         if (want.length() == 0) continue;
         String wantN = normalize(want);
-        for (JsonVariant r : canon) {
-            String nm = String(r["name"] | "");
-            if (normalize(nm) == wantN) {
-                ids[i] = (int)r["id"];
-                labs[i] = nm;
-                changed = true;
-                break;
-            }
-        }
+        const int r = rideCatalogFindName(block, wantN.c_str(), wantN.length());
+        if (r < 0) continue;
+        const RideCatalogRecord& rec = rideCatalogRecords(block)[r];
+        String nm;
+        nm.concat(rideCatalogStrings(block) + rec.nameOff, rec.nameLen);
+        ids[i] = (int)rec.id;
+        labs[i] = nm;
+        changed = true;
     }
+    xSemaphoreGive(rides_catalog_mutex);
     return changed;
 }
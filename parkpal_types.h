@@ -6,44 +6,129 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
+#include <string.h>
+
+// Inline, fixed-capacity string (N bytes + NUL) so config types never touch the heap. Longer input
+// is truncated at a UTF-8 character boundary.
+template <size_t N>
+struct FixedString {
+    char buf[N + 1] = "";
+
+    FixedString() = default;
+    FixedString(const char* s) { assign(s); }
+    FixedString& operator=(const char* s) { assign(s); return *this; }
+    FixedString& operator=(const String& s) { assign(s.c_str(), s.length()); return *this; }
+
+    void assign(const char* s) { assign(s, s ? strlen(s) : 0); }
+    void assign(const char* s, size_t len) {
+        if (!s) len = 0;
+        if (len > N) {
+            len = N;
+            while (len > 0 && ((uint8_t)s[len] & 0xC0) == 0x80) len--; // Don't split a code point
+        }
+        memcpy(buf, s, len);
+        buf[len] = '\0';
+    }
+    const char* c_str() const { return buf; }
+    size_t length() const { return strlen(buf); }
+    bool empty() const { return buf[0] == '\0'; }
+    bool operator==(const char* s) const { return strcmp(buf, s ? s : "") == 0; }
+    bool operator!=(const char* s) const { return !(*this == s); }
+    template <size_t M> bool operator==(const FixedString<M>& o) const { return strcmp(buf, o.buf) == 0; }
+    template <size_t M> bool operator!=(const FixedString<M>& o) const { return !(*this == o); }
+};
+
+const int MAX_COUNTDOWNS = 16; // Matches the web UI's limit
+const int RIDE_LABEL_MAX = 71; // Same as the Worker's ride name clip (summary_codec.h)
+
+typedef FixedString<15> ConfigTag; // Short enum-like values: "parks", "yearly", "auto", ...
+typedef FixedString<63> TzString; // POSIX TZ rule
+typedef FixedString<RIDE_LABEL_MAX> RideLabel;
 
 struct CountdownItem {
-    String id;
-    String label[4];
+    FixedString<31> id;
+    FixedString<47> label[4];
     int year = 0;
     int month = 0;
     int day = 0;
-    String repeat = "yearly"; // "yearly" | "once"
+    ConfigTag repeat = "yearly"; // "yearly" | "once"
     int birth_year = 0;
-    String accent = "auto"; // "auto" | "red" | "black"
+    ConfigTag accent = "auto"; // "auto" | "red" | "black"
     bool include_in_cycle = true;
-    String icon = "auto"; // "auto" | "tree" | "reindeer" | "pumpkin" | "ghost" | "cake" | "none"
+    ConfigTag icon = "auto"; // "auto" | "tree" | "reindeer" | "pumpkin" | "ghost" | "cake" | "none"
 };
 
 struct CountdownSettings {
-    String show_mode = "single"; // "single" | "cycle"
-    String primary_id = "";
+    ConfigTag show_mode = "single"; // "single" | "cycle"
+    FixedString<31> primary_id = "";
     int cycle_every_n_refreshes = 1;
 };
 
+// Plain fixed-size data: copying or rebuilding it never allocates.
 struct RuntimeConfig {
-    String mode = "parks";
-    String resort = "orlando"; // "orlando" | "california" | "tokyo"
-    String parks_tz = "EST5EDT,M3.2.0/2,M11.1.0/2";
-    String countdowns_tz = "EST5EDT,M3.2.0/2,M11.1.0/2";
+    ConfigTag mode = "parks";
+    ConfigTag resort = "orlando"; // "orlando" | "california" | "tokyo"
+    TzString parks_tz = "EST5EDT,M3.2.0/2,M11.1.0/2";
+    TzString countdowns_tz = "EST5EDT,M3.2.0/2,M11.1.0/2";
     CountdownSettings countdownSettings;
-    std::vector<CountdownItem> countdowns;
+    CountdownItem countdowns[MAX_COUNTDOWNS];
+    int countdowns_n = 0;
     bool metric = true;
     bool trip_enabled = true;
-    String trip_date = "2026-12-25";
-    String trip_name = "";
+    ConfigTag trip_date = "2026-12-25";
+    FixedString<47> trip_name = "";
     int parks[4];
     int parks_n = 0;
     int rideIds[4][6];
-    String rideLabels[4][6];
-    String legacyNames[4][6];
+    RideLabel rideLabels[4][6];
+    RideLabel legacyNames[4][6];
 };
 
 enum IconKind { ICON_NONE, ICON_TREE, ICON_REINDEER, ICON_PUMPKIN, ICON_GHOST, ICON_CAKE };
 
+// Answer from the on-device rides catalog for one park (see /api/rides).
+enum RidesCatalogState { RIDES_READY, RIDES_PENDING, RIDES_FAILED };
+
+// Stages of one refresh, timed for /api/metrics.
+enum MetricStage {
+    STAGE_WIFI,    // ensureWiFiConnected()
+    STAGE_DNS,     // Worker host lookup (cache misses only)
+    STAGE_CONNECT, // TCP connect + TLS handshake
+    STAGE_HTTP,    // Request sent until response headers parsed
+    STAGE_PARSE,   // Response body read + decode
+    STAGE_LAYOUT,  // Text measuring / placement before the page loop
+    STAGE_DRAW,    // Page loop, excluding BUSY waits
+    STAGE_BUSY,    // Waiting on the panel's BUSY line
+    STAGE_TOTAL,
+    STAGE_COUNT
+};
+
+struct RefreshSample {
+    uint32_t at = 0; // Unix time (or uptime seconds before NTP)
+    uint32_t us[STAGE_COUNT] = {};
+    uint32_t heap_free = 0;
+    uint32_t heap_min = 0;
+    uint32_t heap_max_block = 0;
+    uint32_t parse_heap = 0; // Peak heap held by a response parse: the JSON document plus any body copy
+    uint8_t full_frame = 0; // 1 when drawn from the PSRAM framebuffer, 0 when paged
+};
+
+// Work for the render task, queued by loop() (see "Tasks" in parkpal.ino).
+enum RenderCmdKind : uint8_t {
+    RENDER_TICK,           // Scheduled refresh (the render task's own timeout)
+    RENDER_REFRESH_NOW,    // Refresh from the web UI: refetch instead of using the park cache
+    RENDER_CONFIG_CHANGED, // Config saved: drop the park cache and frame fingerprint, then refresh
+    RENDER_SET_MODE,       // arg 1 full-frame, 0 paged; then refresh
+    RENDER_BENCH,          // arg: BenchKind
+    RENDER_MESSAGE,        // text (a string literal) in MSG_FONT
+    RENDER_SETUP_SCREEN    // Setup AP name, password and address
+};
+
+// Benchmarks served under /api/bench/<name>, run on the render task.
+enum BenchKind : uint8_t { BENCH_TEXT, BENCH_TZ, BENCH_COUNT };
+
+struct RenderCmd {
+    RenderCmdKind kind;
+    int8_t arg;
+    const char* text;
+};
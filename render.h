@@ -0,0 +1,613 @@
+// render.h - Screen layout and drawing: the display list, text helpers, festive icons and every
+// render function.
+//
+// Shared by parkpal.ino and the host build (host/), which compiles it against a mock GxEPD2 panel
+// for golden-frame tests. The includer defines, before including it: `display` (a FullFrameDisplay),
+// DBG_PRINTF, StageTimer and DrawTimer (refresh metrics), frameOnPanel() and frameShown() (frame
+// fingerprint persistence) and daysToDateInTz(). It is meant to be included once per
+// program.
+
+#pragma once
+
+#include <Arduino.h>
+#include <time.h>
+
+#include "parkpal_types.h"
+#include "ride_catalog.h"
+#include "WeatherIcons.h"
+#include "summary_codec.h"
+#include "display_list.h"
+#include "text_metrics.h"
+#include "render_fonts.h"
+
+// -------------------- Drawing helpers --------------------
+// Render functions lay a frame out once into `frame` (the draw helpers below record into it), then
+// drawFrame() replays it into each page band. Text is measured from cached glyph metrics
+// (text_metrics.h) rather than getTextBounds().
+DisplayList frame;
+
+// 64-bit FNV-1a hash over a frame's render inputs; see "Frame fingerprint" in parkpal.ino.
+struct FrameHash {
+    uint64_t h = 14695981039346656037ULL;
+    FrameHash& add(const void* p, size_t n) {
+        const uint8_t* b = (const uint8_t*)p;
+        for (size_t i = 0; i < n; i++) h = (h ^ b[i]) * 1099511628211ULL;
+        return *this;
+    }
+    FrameHash& add(const char* s) { return add(s, strlen(s) + 1); } // NUL separates fields
+    FrameHash& add(int32_t v) { return add(&v, sizeof v); }
+};
+
+// Pushes the recorded frame, replaying into each page band only the primitives that touch it,
+// unless the panel already shows the frame with this fingerprint.
+void drawFrame(uint64_t hash) {
+    if (frameOnPanel(hash)) return;
+    if (frame.dropped()) DBG_PRINTF("Display list full: %d primitives dropped\n", frame.dropped());
+    display.setFullWindow();
+    display.firstPage();
+    do {
+        display.fillScreen(GxEPD_WHITE);
+        int16_t x, y, w, h;
+        display.pageRect(x, y, w, h);
+        frame.replay(display, x, y, w, h);
+    } while (display.nextPage());
+    frameShown(hash);
+}
+
+// Glyph metrics for the fonts in use, built on first use (the render task is the only caller).
+static FontMetrics font_metrics[8];
+static int font_metrics_next = 0;
+
+static const FontMetrics& fontMetrics(const GFXfont* f) {
+    for (const FontMetrics& m : font_metrics)
+        if (m.font == f) return m;
+    FontMetrics& m = font_metrics[font_metrics_next];
+    font_metrics_next = (font_metrics_next + 1) % 8;
+    fontMetricsBuild(m, f);
+    return m;
+}
+
+void drawText(int16_t x, int16_t y, const char* s, const GFXfont* f, uint16_t color) {
+    const FontMetrics& m = fontMetrics(f);
+    const TextExtent e = textExtent(m, s, strlen(s));
+    if (!e.width()) return;
+    frame.text(x, y, s, f, color, x + e.minx, y + m.yMin, x + e.maxx, y + m.yMax);
+}
+
+int16_t textWidth(const char* s, const GFXfont* f) {
+    return textExtent(fontMetrics(f), s, strlen(s)).width();
+}
+
+// Room for a clipped string: the longest prefix clipTextLength() returns, "..." and the NUL.
+typedef char ClipBuffer[TEXT_METRICS_MAX_CHARS + 4];
+
+// `s` if it fits in maxW; otherwise its longest prefix that does (followed by "..." if `ellipsis`),
+// written to `out`. Nothing is allocated, so the render path can clip every row.
+const char* clipToWidth(const char* s, const GFXfont* f, int16_t maxW, bool ellipsis, ClipBuffer& out) {
+    if (maxW <= 0) return "";
+    const FontMetrics& m = fontMetrics(f);
+    const size_t n = strlen(s);
+    if (textExtent(m, s, n).width() <= maxW) return s;
+    const char* dots = ellipsis ? "..." : "";
+    if (ellipsis && textExtent(m, dots, 3).width() >= maxW) return "";
+    const size_t keep = clipTextLength(m, s, n, maxW, dots);
+    memcpy(out, s, keep);
+    strcpy(out + keep, dots);
+    return out;
+}
+
+const GFXfont* pickLargestFontThatFits(const char* s, int16_t maxW, const GFXfont* a, const GFXfont* b, const GFXfont* c) {
+    if (textWidth(s, a) <= maxW) return a;
+    if (textWidth(s, b) <= maxW) return b;
+    return c;
+}
+
+void drawRight(int16_t rightX, int16_t baselineY, const char* s, const GFXfont* f, uint16_t color) {
+    drawText(rightX - textWidth(s, f), baselineY, s, f, color);
+}
+
+inline void thickH(int x1, int y, int x2, uint16_t c) {
+    frame.drawLine(x1, y, x2, y, c);
+    frame.drawLine(x1, y + 1, x2, y + 1, c);
+}
+
+inline void thickV(int x, int y1, int y2, uint16_t c) {
+    frame.drawLine(x, y1, x, y2, c);
+    frame.drawLine(x + 1, y1, x + 1, y2, c);
+}
+
+void drawDegreeMark(int16_t cx, int16_t cy, int16_t outerR, uint16_t color) {
+    // E-ink can render 1px outlines very faintly; use a filled ring for contrast.
+    outerR = max<int16_t>(2, outerR);
+    frame.fillCircle(cx, cy, outerR, color);
+    int16_t innerR = outerR - 2;
+    if (innerR > 0) frame.fillCircle(cx, cy, innerR, GxEPD_WHITE);
+}
+
+
+void drawCenterLine(int16_t baselineY, const char* s, const GFXfont* f, uint16_t color) {
+    int16_t availableWidth = display.width() - 2 * BORDER_MARGIN;
+    ClipBuffer clip;
+    const char* clipped_s = clipToWidth(s, f, availableWidth, false, clip);
+    int16_t x = (display.width() - textWidth(clipped_s, f)) / 2;
+    drawText(x, baselineY, clipped_s, f, color);
+}
+
+
+int16_t lineHeight(const GFXfont* f) {
+    return fontMetrics(f).hgHeight + 6;
+}
+
+// ====== FESTIVE ICONS =================================================
+
+IconKind pickIcon(const CountdownItem& c) {
+    // Explicit override
+    if (c.icon == "tree") return ICON_TREE;
+    if (c.icon == "reindeer") return ICON_REINDEER;
+    if (c.icon == "pumpkin") return ICON_PUMPKIN;
+    if (c.icon == "ghost") return ICON_GHOST;
+    if (c.icon == "cake") return ICON_CAKE;
+    if (c.icon == "none") return ICON_NONE;
+    // AUTO: infer by label/date
+    char L[sizeof(c.label)];
+    size_t n = 0;
+    for (int i = 0; i < 4; i++) {
+        for (const char* p = c.label[i].c_str(); *p; p++) L[n++] = (char)tolower((uint8_t)*p);
+        L[n++] = ' ';
+    }
+    L[n - 1] = '\0';
+    if (strstr(L, "christmas")) return ICON_TREE;
+    if (strstr(L, "halloween")) return ICON_PUMPKIN;
+    if (strstr(L, "ghost")) return ICON_GHOST;
+    if (strstr(L, "reindeer")) return ICON_REINDEER;
+    if (strstr(L, "birthday") || c.birth_year > 0) return ICON_CAKE;
+    if (c.repeat == "yearly") {
+        if (c.month == 12 && c.day >= 20 && c.day <= 26) return ICON_TREE;
+        if (c.month == 10 && c.day >= 25 && c.day <= 31) return ICON_PUMPKIN;
+        if (c.month == 1 && c.day == 1) return ICON_REINDEER; // playful
+    }
+    return ICON_NONE;
+}
+
+// helper
+void fillTriangleI(int x0, int y0, int x1, int y1, int x2, int y2, uint16_t c) {
+    frame.fillTriangle(x0, y0, x1, y1, x2, y2, c);
+}
+
+// TREE
+void drawIconTree(int cx, int cy, int s, uint16_t c) {
+    int w = s, h = s;
+    // three stacked triangles
+    fillTriangleI(cx - w * 0.35, cy - h * 0.35, cx + w * 0.35, cy - h * 0.35, cx, cy - h * 0.65, c);
+    fillTriangleI(cx - w * 0.45, cy - h * 0.10, cx + w * 0.45, cy - h * 0.10, cx, cy - h * 0.45, c);
+    fillTriangleI(cx - w * 0.55, cy + h * 0.15, cx + w * 0.55, cy + h * 0.15, cx, cy - h * 0.20, c);
+    // trunk
+    int tw = w * 0.14, th = h * 0.18;
+    frame.fillRect(cx - tw / 2, cy + h * 0.15, tw, th, c);
+}
+
+// REINDEER (minimal)
+void drawIconReindeer(int cx, int cy, int s, uint16_t c, uint16_t noseC) {
+    int r = s / 4;
+    frame.fillCircle(cx, cy, r, c); // head
+    // antlers
+    for (int i = 0; i < 3; i++) {
+        frame.drawLine(cx - r, cy - r + i * 3, cx - r - s * 0.25, cy - r - s * 0.10 + i * 2, c);
+        frame.drawLine(cx + r, cy - r + i * 3, cx + r + s * 0.25, cy - r - s * 0.10 + i * 2, c);
+    }
+    frame.fillCircle(cx, cy + r * 0.9, r * 0.35, noseC); // nose
+}
+
+// PUMPKIN (three overlapping circles + stem + grooves)
+void drawIconPumpkin(int cx, int cy, int s, uint16_t c) {
+    int r = s * 0.28;
+    frame.fillCircle(cx - r, cy, r, c);
+    frame.fillCircle(cx, cy, r * 1.15, c);
+    frame.fillCircle(cx + r, cy, r, c);
+    // stem
+    frame.fillRect(cx - s * 0.05, cy - r * 1.6, s * 0.10, r * 0.9, c);
+    // grooves (thin vertical lines knocked out)
+    int bodyW = r * 3;
+    for (int i = -2; i <= 2; i++) {
+        int x = cx + i * (bodyW / 10);
+        frame.drawFastVLine(x, cy - r * 1.15, r * 2.3, GxEPD_WHITE);
+    }
+}
+
+// GHOST
+void drawIconGhost(int cx, int cy, int s, uint16_t c) {
+    int r = s / 2;
+    frame.fillCircle(cx, cy - r * 0.3, r * 0.7, c); // head
+    frame.fillRect(cx - r * 0.7, cy - r * 0.3, r * 1.4, r * 0.9, c); // body
+    // scalloped bottom
+    for (int i = -2; i <= 2; i++) {
+        frame.fillCircle(cx + i * (r * 0.5), cy + r * 0.45, r * 0.3, c);
+    }
+    // eyes (white cutouts)
+    frame.fillCircle(cx - r * 0.25, cy - r * 0.25, r * 0.10, GxEPD_WHITE);
+    frame.fillCircle(cx + r * 0.25, cy - r * 0.25, r * 0.10, GxEPD_WHITE);
+}
+
+// CAKE
+void drawIconCake(int cx, int cy, int s, uint16_t c, uint16_t accent) {
+    int w = s, h = s * 0.6;
+    int x = cx - w / 2, y = cy - h / 2;
+    frame.fillRect(x, y + h * 0.35, w, h * 0.65, c); // base
+    frame.fillRect(x, y + h * 0.25, w, h * 0.12, accent); // frosting stripe
+    // candle
+    int cw = w * 0.08, ch = h * 0.35;
+    frame.fillRect(cx - cw / 2, y, cw, ch, c);
+    // flame
+    frame.fillCircle(cx, y - h * 0.02, cw, accent);
+}
+
+void drawIcon(IconKind k, int x, int y, int size) {
+    if (k == ICON_NONE) return;
+    int cx = x + size / 2, cy = y + size / 2;
+    switch (k) {
+    case ICON_TREE:
+        drawIconTree(cx, cy, size, GxEPD_BLACK);
+        break;
+    case ICON_REINDEER:
+        drawIconReindeer(cx, cy, size, GxEPD_BLACK, GxEPD_RED);
+        break;
+    case ICON_PUMPKIN:
+        drawIconPumpkin(cx, cy, size, GxEPD_BLACK);
+        break;
+    case ICON_GHOST:
+        drawIconGhost(cx, cy, size, GxEPD_BLACK);
+        break;
+    case ICON_CAKE:
+        drawIconCake(cx, cy, size, GxEPD_BLACK, GxEPD_RED);
+        break;
+    default:
+        break;
+    }
+}
+
+// =====================================================================
+// -------------------- Render: Parks --------------------
+void renderParks(const ParkSummary& summary, const int rideIds[6], const RideLabel rideLabels[6], const char* parkName, bool metricUnits, bool showTrip, const char* tripISO, const char* tripName, const RideLabel legacyFallback[6], const char* parksTz) {
+    StageTimer layout(STAGE_LAYOUT);
+    int temp = summary.temp;
+    const char* desc = summary.desc;
+    int wcode = summary.code;
+    long sunrise = (long)summary.sunrise;
+    long sunset  = (long)summary.sunset;
+    time_t now;
+    time(&now);
+    bool isNight = false;
+    if (sunrise > 0 && sunset > 0 && now > 1700000000)
+        isNight = (now < (time_t)sunrise || now > (time_t)sunset);
+    struct Row {
+        const char* name; // Into `summary` or the labels
+        bool open;
+        int wait;
+    };
+    Row rows[6];
+    int count = 0;
+    for (int s = 0; s < 6; s++) {
+        int dId = rideIds[s];
+        const char* want = !rideLabels[s].empty() ? rideLabels[s].c_str() : legacyFallback[s].c_str();
+        if (dId == 0 && !*want) continue;
+        // Label-only slots (no ride id) match by normalized name.
+        char wantN[RIDE_LABEL_MAX + 1];
+        if (dId == 0) {
+            snprintf(wantN, sizeof wantN, "%s", want);
+            rideNameNormalize(wantN);
+        }
+        bool found = false;
+        for (int r = 0; r < summary.rides_n; r++) {
+            const RideStatus& ri = summary.rides[r];
+            bool isMatch = false;
+            if (dId > 0 && ri.id == dId) isMatch = true;
+            else if (dId == 0) {
+                char apiN[sizeof ri.name];
+                memcpy(apiN, ri.name, sizeof apiN);
+                rideNameNormalize(apiN);
+                if (strcmp(apiN, wantN) == 0) isMatch = true;
+            }
+            if (isMatch) {
+                if (strstr(ri.name, "Single Rider")) continue;
+                rows[count++] = {ri.name, ri.open, (int)ri.wait};
+                found = true;
+                break;
+            }
+        }
+        if (!found && *want) rows[count++] = {want, false, -1};
+        if (count >= 6) break;
+    }
+    int days = 0;
+    bool haveTime = false;
+    if (showTrip) haveTime = daysToDateInTz(tripISO, parksTz, days);
+    FrameHash fh;
+    fh.add("parks").add(parkName).add(temp).add(desc).add(wcode).add(isNight).add(metricUnits);
+    fh.add(showTrip).add(haveTime).add(days).add(tripName).add(count);
+    for (int i = 0; i < count; i++) fh.add(rows[i].name).add(rows[i].open).add(rows[i].wait);
+    if (frameOnPanel(fh.h)) return;
+    
+    const int16_t W = display.width(), H = display.height(), M = BORDER_MARGIN, MID_X = W / 2;
+    
+    const GFXfont* titleFont = &FreeSansBold12pt7b;
+    const GFXfont* subContentFont = &FreeSans12pt7b;
+    const GFXfont* largeNumFont = &FreeSansBold24pt7b;
+    const GFXfont* largeDaysFont = &FreeSansBold18pt7b;
+
+    int16_t titleHeight = lineHeight(titleFont);
+    int16_t numHeight = lineHeight(largeNumFont);
+    int16_t contentPadding = 20;
+    
+    // Header height covers the title row + one content row in each column.
+    int16_t maxHeaderContentHeight = titleHeight + contentPadding + numHeight;
+    int16_t dynamicHeaderHeight = M + maxHeaderContentHeight + 20;
+
+    frame.clear();
+    thickV(MID_X, M, dynamicHeaderHeight, GxEPD_BLACK);
+    thickH(M, dynamicHeaderHeight, W - M, GxEPD_BLACK);
+
+    int16_t currentY;
+
+    // --- Left Column: Trip Countdown ---
+    currentY = M + titleHeight;
+    const int16_t leftMaxW = (MID_X - 10) - M;
+    if (showTrip) {
+        if (haveTime) {
+            char untilLine[24];
+            snprintf(untilLine, sizeof untilLine, "%d DAYS UNTIL", days);
+            ClipBuffer clip;
+            drawText(M, currentY, clipToWidth(untilLine, titleFont, leftMaxW, true, clip), titleFont, GxEPD_BLACK);
+        } else {
+            drawText(M, currentY, "TRIP COUNTDOWN", titleFont, GxEPD_BLACK);
+        }
+    }
+
+    const int16_t contentY = currentY + numHeight + contentPadding;
+    if (showTrip) {
+        if (haveTime) {
+            const char* effectiveTripName = *tripName ? tripName : "My Trip";
+            const GFXfont* tripFont = pickLargestFontThatFits(effectiveTripName, leftMaxW, largeNumFont, largeDaysFont, titleFont);
+            ClipBuffer clip;
+            drawText(M, contentY, clipToWidth(effectiveTripName, tripFont, leftMaxW, true, clip), tripFont, GxEPD_BLACK);
+        } else {
+            drawText(M, contentY, "—", largeNumFont, GxEPD_RED);
+        }
+    } else {
+        drawText(M, currentY, "PARKPAL", titleFont, GxEPD_BLACK);
+        drawText(M, contentY, "LIVE WAIT TIMES", largeDaysFont, GxEPD_BLACK);
+    }
+
+    // --- Right Column: Weather ---
+    int16_t c2X = MID_X + 25; // Shift closer to the middle line
+    currentY = M + titleHeight;
+    drawText(c2X, currentY, "WEATHER", titleFont, GxEPD_BLACK);
+    
+    currentY = contentY;
+    // NOTE: FreeSans GFX fonts are ASCII-only; draw the degree symbol manually.
+    char tempNum[12];
+    snprintf(tempNum, sizeof tempNum, "%d", temp);
+    const char* unit = metricUnits ? "C" : "F";
+    drawText(c2X, currentY, tempNum, largeNumFont, GxEPD_BLACK);
+
+    // Compute bounds for positioning the degree symbol near the top-right of the number.
+    const FontMetrics& numMetrics = fontMetrics(largeNumFont);
+    const TextExtent numExtent = textExtent(numMetrics, tempNum, strlen(tempNum));
+    int16_t numTop, numBottom;
+    if (!textRows(numMetrics, tempNum, strlen(tempNum), numTop, numBottom)) numTop = numBottom = 0;
+    const int16_t bx = c2X + numExtent.minx, by = currentY + numTop;
+    const uint16_t bw = numExtent.width(), bh = numBottom - numTop + 1;
+    int16_t degreeR = (int16_t)max(3, min(7, (int)(bh / 6)));
+    int16_t degreeCx = bx + (int16_t)bw + degreeR + 3;
+    int16_t degreeCy = by + degreeR + 2;
+    drawDegreeMark(degreeCx, degreeCy, degreeR, GxEPD_BLACK);
+
+    int16_t unitX = degreeCx + degreeR + 4;
+    drawText(unitX, currentY, unit, largeNumFont, GxEPD_BLACK);
+
+    // Weather condition icon
+    int16_t iconW = WEATHER_ICON_W, iconH = WEATHER_ICON_H;
+    int16_t iconX = unitX + textWidth(unit, largeNumFont) + 14;
+    // Center the icon roughly against the temperature number, even if the icon is taller.
+    int16_t iconY = by - (int16_t)max(0, ((int)iconH - (int)bh) / 2);
+    if (iconX + iconW > (W - M)) iconX = (W - M) - iconW;
+    if (const uint8_t* bmp = weatherIconBitmap(wcode, desc, isNight)) {
+        frame.drawBitmap(iconX, iconY, bmp, iconW, iconH, GxEPD_BLACK);
+    } else {
+        // Unknown: small dash centered in the icon box
+        frame.fillRect(iconX + iconW / 2 - 4, iconY + iconH / 2 - 1, 8, 3, GxEPD_BLACK);
+    }
+    
+    // --- Ride List / Setup Instructions ---
+    int16_t listHeaderY = dynamicHeaderHeight + 24;
+    const int16_t listTop = listHeaderY + lineHeight(titleFont) + 5;
+    if (count == 0) {
+        const int16_t top = dynamicHeaderHeight + 40;
+        const int16_t bottom = H - M;
+
+        if (!showTrip) {
+            const GFXfont* hFont = &FreeSansBold18pt7b;
+            const GFXfont* tFont = &FreeSans12pt7b;
+            const int16_t h1 = lineHeight(hFont);
+            const int16_t h2 = lineHeight(tFont);
+            const int16_t total = h1 + 10 + (h2 * 3);
+            int16_t y = top + max<int16_t>(0, (int16_t)((bottom - top - total) / 2)) + h1;
+            drawCenterLine(y, "GET STARTED", hFont, GxEPD_BLACK);
+            y += h1 + 10;
+            drawCenterLine(y, "Open parkpal.local", tFont, GxEPD_RED);
+            y += h2;
+            drawCenterLine(y, "on the same Wi-Fi network", tFont, GxEPD_BLACK);
+            y += h2;
+            drawCenterLine(y, "to set up your trip", tFont, GxEPD_BLACK);
+        } else {
+            const GFXfont* hFont = &FreeSansBold18pt7b;
+            const GFXfont* tFont = &FreeSans12pt7b;
+            const int16_t h1 = lineHeight(hFont);
+            const int16_t h2 = lineHeight(tFont);
+            const int16_t total = h1 + 10 + (h2 * 3);
+            int16_t y = top + max<int16_t>(0, (int16_t)((bottom - top - total) / 2)) + h1;
+            drawCenterLine(y, "NO RIDES YET", hFont, GxEPD_BLACK);
+            y += h1 + 10;
+            drawCenterLine(y, "Open parkpal.local", tFont, GxEPD_RED);
+            y += h2;
+            drawCenterLine(y, "to choose a park + rides", tFont, GxEPD_BLACK);
+            y += h2;
+            drawCenterLine(y, "then hit Refresh", tFont, GxEPD_BLACK);
+        }
+    } else {
+        drawText(M, listHeaderY, parkName, titleFont, GxEPD_RED);
+        const int16_t rowH = 36; // Fits 6 rows comfortably on 7.5" 528px height with our margins
+        const int16_t waitColR = W - M;
+        int16_t y = listTop;
+        for (int i = 0; i < count; i++) {
+            if (y > (H - M)) break;
+            int16_t maxW = (W - M - M) - 140;
+            ClipBuffer clip;
+            drawText(M, y, clipToWidth(rows[i].name, subContentFont, maxW, true, clip), subContentFont, GxEPD_BLACK);
+
+            if (rows[i].wait == -1) drawRight(waitColR, y, "Unavailable", titleFont, GxEPD_RED);
+            else if (rows[i].open) {
+                char wait[16];
+                snprintf(wait, sizeof wait, "%d min", rows[i].wait);
+                drawRight(waitColR, y, wait, titleFont, GxEPD_BLACK);
+            } else drawRight(waitColR, y, "Closed", titleFont, GxEPD_RED);
+
+            if (i < count - 1) {
+                thickH(M, y + 10, W - M, GxEPD_BLACK);
+            }
+            y += rowH;
+        }
+    }
+    layout.stop();
+    DrawTimer draw;
+    drawFrame(fh.h);
+}
+
+
+// -------------------- Render: Countdowns & Messages --------------------
+
+void renderMessage(const char* msg, const GFXfont* font) {
+    DrawTimer draw;
+    frame.clear();
+    drawCenterLine(display.height() / 2, msg, font, GxEPD_BLACK);
+    drawFrame(FrameHash().add("message").add(msg).add((int32_t)(uintptr_t)font).h);
+}
+
+void renderGetStarted() {
+    DrawTimer draw;
+    frame.clear();
+    const GFXfont* hFont = &FreeSansBold18pt7b;
+    const GFXfont* tFont = &FreeSans12pt7b;
+    const int16_t h1 = lineHeight(hFont);
+    const int16_t h2 = lineHeight(tFont);
+    const int16_t total = h1 + 10 + (h2 * 3);
+    const int16_t top = BORDER_MARGIN;
+    const int16_t bottom = display.height() - BORDER_MARGIN;
+    int16_t y = top + max<int16_t>(0, (int16_t)((bottom - top - total) / 2)) + h1;
+    drawCenterLine(y, "GET STARTED", hFont, GxEPD_BLACK);
+    y += h1 + 10;
+    drawCenterLine(y, "Open parkpal.local", tFont, GxEPD_RED);
+    y += h2;
+    drawCenterLine(y, "on the same Wi-Fi network", tFont, GxEPD_BLACK);
+    y += h2;
+    drawCenterLine(y, "to set up your trip", tFont, GxEPD_BLACK);
+    drawFrame(FrameHash().add("get_started").h);
+}
+
+void renderCountdowns(const CountdownItem& active, int days, int turnsAge) {
+    StageTimer layout(STAGE_LAYOUT);
+    // Redundant frame skip
+    FrameHash fh;
+    fh.add("countdown").add(active.id.c_str()).add(days).add(turnsAge).add(active.icon.c_str());
+    fh.add(active.accent.c_str()).add(active.repeat.c_str());
+    for (int i = 0; i < 4; i++) fh.add(active.label[i].c_str());
+    if (frameOnPanel(fh.h)) return;
+    const int16_t W = display.width(), H = display.height(), M = BORDER_MARGIN;
+    const int16_t GAP_BEFORE_NUMBER = 18, GAP_BEFORE_AGE = 10;
+    int labelLines = 0;
+    for (int i = 0; i < 4; i++)
+        if (active.label[i].length()) labelLines++;
+    int16_t hLabels = labelLines * lineHeight(LABEL_FONT);
+    int16_t hNumber = lineHeight(NUM_FONT);
+    int16_t hDays = (days > 0) ? lineHeight(DAYS_FONT) : 0;
+    int16_t hAge = (days == 0 && turnsAge > 0) ? lineHeight(AGE_FONT) : 0;
+    int16_t total = hLabels + (labelLines ? GAP_BEFORE_NUMBER : 0) + (days == 0 ? (hNumber + (hAge ? (GAP_BEFORE_AGE + hAge) : 0)) : (hNumber + hDays));
+    const int16_t y0 = (H - total) / 2; // stable baseline each page
+    // ---- Icon placement (above labels if space, else top-right) ----
+    IconKind icon = pickIcon(active);
+    const int16_t PAD = BORDER_MARGIN;
+    int iconSize = 120;
+    int iconX = 0, iconY = 0;
+    int16_t topFree = y0 - PAD; // space from top to first content line
+    if (icon != ICON_NONE && topFree > 80) {
+        iconSize = min(iconSize, (int)topFree - PAD);
+        if (iconSize < 56) iconSize = 56;
+        iconX = (W - iconSize) / 2;
+        iconY = std::max<int>((int)PAD, (int)(y0 - PAD - iconSize));
+    } else if (icon != ICON_NONE) {
+        iconSize = 96;
+        iconX = W - iconSize - PAD;
+        iconY = PAD;
+    }
+    frame.clear();
+    // Icon first, so labels draw over it
+    if (icon != ICON_NONE) drawIcon(icon, iconX, iconY, iconSize);
+    int16_t y = y0;
+    // Labels
+    for (int i = 0; i < 4; i++) {
+        const char* line = active.label[i].c_str();
+        if (!*line) continue;
+        drawCenterLine(y, line, LABEL_FONT, GxEPD_BLACK);
+        y += lineHeight(LABEL_FONT);
+    }
+    if (labelLines) y += GAP_BEFORE_NUMBER;
+    if (days == 0) {
+        const char* msg = (active.repeat == "once") ? "DONE!" : "TODAY!";
+        drawCenterLine(y, msg, NUM_FONT, GxEPD_RED);
+        y += lineHeight(NUM_FONT);
+        if (hAge) {
+            y += GAP_BEFORE_AGE;
+            char turns[20];
+            snprintf(turns, sizeof turns, "turns %d", turnsAge);
+            drawCenterLine(y, turns, AGE_FONT, GxEPD_BLACK);
+        }
+    } else {
+        uint16_t numColor = GxEPD_BLACK;
+        if (active.accent == "red" || (active.accent == "auto" && days <= 3)) numColor = GxEPD_RED;
+        char dayStr[12];
+        snprintf(dayStr, sizeof dayStr, "%d", days);
+        drawCenterLine(y, dayStr, NUM_FONT, numColor);
+        y += lineHeight(NUM_FONT);
+        drawCenterLine(y, "DAYS", DAYS_FONT, GxEPD_BLACK);
+    }
+    layout.stop();
+    DrawTimer draw;
+    drawFrame(fh.h);
+}
+
+// -------------------- Render: Setup & Boot --------------------
+
+void renderSetupScreen(const char* apSsid, const char* apPass) {
+    frame.clear();
+    drawText(BORDER_MARGIN, BORDER_MARGIN + 40, "PARKPAL SETUP", &FreeSansBold18pt7b, GxEPD_BLACK);
+    int y = BORDER_MARGIN + 100;
+    drawText(BORDER_MARGIN, y, "Wi-Fi:", &FreeSans12pt7b, GxEPD_BLACK);
+    y += 30;
+    drawText(BORDER_MARGIN, y, apSsid, &FreeSansBold12pt7b, GxEPD_BLACK);
+    y += 40;
+    drawText(BORDER_MARGIN, y, "Password:", &FreeSans12pt7b, GxEPD_BLACK);
+    y += 30;
+    drawText(BORDER_MARGIN, y, *apPass ? apPass : "(none)", &FreeSansBold12pt7b, GxEPD_BLACK);
+    y += 50;
+    drawText(BORDER_MARGIN, y, "Open: http://192.168.4.1", &FreeSans12pt7b, GxEPD_BLACK);
+    drawFrame(FrameHash().add("setup").add(apSsid).add(apPass).h);
+}
+
+void renderBootScreen(bool wifiConnected, const char* ip) {
+    frame.clear();
+    drawText(BORDER_MARGIN, BORDER_MARGIN + 40, "ParkPal", &FreeSansBold18pt7b, GxEPD_BLACK);
+    drawText(BORDER_MARGIN, BORDER_MARGIN + 80, wifiConnected ? "WiFi connected" : "WiFi offline", &FreeSans12pt7b, wifiConnected ? GxEPD_BLACK : GxEPD_RED);
+    drawText(BORDER_MARGIN, BORDER_MARGIN + 110, "Open: parkpal.local", &FreeSans12pt7b, GxEPD_BLACK);
+    char ipLine[24];
+    snprintf(ipLine, sizeof ipLine, "IP: %s", ip);
+    drawText(BORDER_MARGIN, BORDER_MARGIN + 140, ipLine, &FreeSans12pt7b, GxEPD_BLACK);
+    drawFrame(FrameHash().add("boot").add(wifiConnected).add(ip).h);
+}
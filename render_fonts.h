@@ -0,0 +1,26 @@
+// render_fonts.h - Fonts and the page margin the renderers (render.h) lay frames out with.
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+
+#include <Fonts/FreeSans9pt7b.h>
+#include <Fonts/FreeSans12pt7b.h>
+#include <Fonts/FreeSansBold12pt7b.h>
+#include <Fonts/FreeSansBold18pt7b.h>
+#include <Fonts/FreeSansBold24pt7b.h>
+// Optional custom giant numeric font
+// #include "BigDigits_120pt.h"
+
+const int16_t BORDER_MARGIN = 75; // The new margin for all sides
+
+const GFXfont* const LABEL_FONT = &FreeSansBold18pt7b;
+#ifdef BigDigits_120pt_h
+extern const GFXfont BigDigits_120pt;
+const GFXfont* const NUM_FONT = &BigDigits_120pt;
+#else
+const GFXfont* const NUM_FONT = &FreeSansBold24pt7b;
+#endif
+const GFXfont* const DAYS_FONT = &FreeSansBold18pt7b;
+const GFXfont* const AGE_FONT = &FreeSans12pt7b;
+const GFXfont* const MSG_FONT = &FreeSansBold12pt7b;
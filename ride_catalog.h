@@ -0,0 +1,211 @@
+// ride_catalog.h - Flash layout of the on-device ride catalog (one block per park).
+//
+// The "catalog" partition (partitions.csv) is split into RIDE_CATALOG_BLOCK-sized blocks, each
+// holding one park's ride list. The firmware reads blocks in place through esp_partition_mmap, so
+// lookups are binary searches over flash with no RAM copy. A block is rewritten only when the
+// Worker's /v1/rides reports a different catalog version. Little-endian, all tables 4-byte aligned:
+//
+//   off  size  field
+//   0    4     magic "PPC" + version byte (written last, so a torn write reads as empty)
+//   4    4     park id
+//   8    4     catalog version (from the Worker)
+//   12   4     write sequence (the lowest is recycled first when every block is in use)
+//   16   2     ride count n
+//   18   2     reserved
+//   20   4     string bytes
+//   24   8     reserved
+//   32   16*n  RideCatalogRecord, sorted by ride id
+//   .    2*n   record indexes sorted by normalized name (padded to 4 bytes)
+//   .          strings: display names and normalized names, not NUL-terminated
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+
+static const uint8_t RIDE_CATALOG_FORMAT = 1;
+static const uint32_t RIDE_CATALOG_MAGIC = 0x00435050u | ((uint32_t)RIDE_CATALOG_FORMAT << 24); // "PPC" + format
+static const size_t RIDE_CATALOG_BLOCK = 16 * 1024; // Multiple of the 4 KB erase sector
+static const uint8_t RIDE_CATALOG_SUBTYPE = 0x40; // Custom data subtype in partitions.csv
+
+struct RideCatalogHeader {
+    uint32_t magic;
+    uint32_t parkId;
+    uint32_t version;
+    uint32_t seq;
+    uint16_t count;
+    uint16_t reserved0;
+    uint32_t stringBytes;
+    uint32_t reserved1[2];
+};
+
+struct RideCatalogRecord {
+    uint32_t id;
+    uint32_t nameOff; // Into the string area
+    uint32_t normOff;
+    uint16_t nameLen;
+    uint16_t normLen;
+};
+
+static_assert(sizeof(RideCatalogHeader) == 32, "catalog header layout");
+static_assert(sizeof(RideCatalogRecord) == 16, "catalog record layout");
+
+// One ride handed to rideCatalogBuild(); the strings only need to live for the call.
+struct RideCatalogInput {
+    uint32_t id;
+    const char* name;
+    uint16_t nameLen;
+    const char* norm;
+    uint16_t normLen;
+};
+
+// Replaces every `from` in `s` with `to`, left to right, in place. `to` must not be longer.
+static inline void rideNameReplace(char* s, const char* from, const char* to) {
+    const size_t fromLen = strlen(from), toLen = strlen(to);
+    char* w = s;
+    for (const char* r = s; *r;) {
+        if (strncmp(r, from, fromLen) == 0) {
+            memcpy(w, to, toLen);
+            w += toLen;
+            r += fromLen;
+        } else {
+            *w++ = *r++;
+        }
+    }
+    *w = '\0';
+}
+
+// Turns a ride name into the key the name index is sorted by, in place, and returns its length:
+// typographic quotes and dashes become ASCII, spaces around '/' and ™/® go, runs of spaces collapse,
+// then it is trimmed and ASCII-lowercased. Every step only shrinks the string, so no buffer is needed.
+static inline size_t rideNameNormalize(char* s) {
+    rideNameReplace(s, "’", "'");
+    rideNameReplace(s, "‘", "'");
+    rideNameReplace(s, "“", "\"");
+    rideNameReplace(s, "”", "\"");
+    rideNameReplace(s, "–", "-");
+    rideNameReplace(s, "—", "-");
+    rideNameReplace(s, " / ", "/");
+    rideNameReplace(s, " /", "/");
+    rideNameReplace(s, "/ ", "/");
+    rideNameReplace(s, "™", "");
+    rideNameReplace(s, "®", "");
+    while (strstr(s, "  ")) rideNameReplace(s, "  ", " ");
+    const auto space = [](char c) { return c == ' ' || (c >= '\t' && c <= '\r'); };
+    size_t start = 0, end = strlen(s);
+    while (start < end && space(s[start])) start++;
+    while (end > start && space(s[end - 1])) end--;
+    memmove(s, s + start, end - start);
+    s[end - start] = '\0';
+    for (char* p = s; *p; p++)
+        if (*p >= 'A' && *p <= 'Z') *p += 'a' - 'A';
+    return end - start;
+}
+
+static inline size_t rideCatalogIndexBytes(uint16_t n) {
+    return ((size_t)n * 2 + 3) & ~(size_t)3;
+}
+
+static inline const RideCatalogHeader* rideCatalogHeader(const uint8_t* block) {
+    return (const RideCatalogHeader*)block;
+}
+
+static inline const RideCatalogRecord* rideCatalogRecords(const uint8_t* block) {
+    return (const RideCatalogRecord*)(block + sizeof(RideCatalogHeader));
+}
+
+static inline const uint16_t* rideCatalogNameIndex(const uint8_t* block) {
+    return (const uint16_t*)(block + sizeof(RideCatalogHeader) + rideCatalogHeader(block)->count * sizeof(RideCatalogRecord));
+}
+
+static inline const char* rideCatalogStrings(const uint8_t* block) {
+    const uint16_t n = rideCatalogHeader(block)->count;
+    return (const char*)(block + sizeof(RideCatalogHeader) + n * sizeof(RideCatalogRecord) + rideCatalogIndexBytes(n));
+}
+
+static inline bool rideCatalogValid(const uint8_t* block) {
+    const RideCatalogHeader* h = rideCatalogHeader(block);
+    if (h->magic != RIDE_CATALOG_MAGIC) return false;
+    const size_t used = sizeof(RideCatalogHeader) + h->count * sizeof(RideCatalogRecord) +
+                        rideCatalogIndexBytes(h->count) + h->stringBytes;
+    return used <= RIDE_CATALOG_BLOCK;
+}
+
+// Index of the record for `rideId`, or -1.
+static inline int rideCatalogFindId(const uint8_t* block, uint32_t rideId) {
+    const RideCatalogRecord* recs = rideCatalogRecords(block);
+    int lo = 0, hi = (int)rideCatalogHeader(block)->count - 1;
+    while (lo <= hi) {
+        const int mid = (lo + hi) / 2;
+        if (recs[mid].id == rideId) return mid;
+        if (recs[mid].id < rideId) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+static inline int rideCatalogCompare(const char* a, size_t aLen, const char* b, size_t bLen) {
+    const int c = memcmp(a, b, std::min(aLen, bLen));
+    if (c) return c;
+    return aLen < bLen ? -1 : (aLen > bLen ? 1 : 0);
+}
+
+// Index of the record whose normalized name equals `norm`, or -1.
+static inline int rideCatalogFindName(const uint8_t* block, const char* norm, size_t normLen) {
+    const RideCatalogRecord* recs = rideCatalogRecords(block);
+    const uint16_t* byName = rideCatalogNameIndex(block);
+    const char* strings = rideCatalogStrings(block);
+    int lo = 0, hi = (int)rideCatalogHeader(block)->count - 1;
+    while (lo <= hi) {
+        const int mid = (lo + hi) / 2;
+        const RideCatalogRecord& r = recs[byName[mid]];
+        const int c = rideCatalogCompare(strings + r.normOff, r.normLen, norm, normLen);
+        if (c == 0) return byName[mid];
+        if (c < 0) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+// Lays out a complete block in `out` (sorting `rides` by id in place). Returns the bytes used, or 0
+// if the list does not fit in `cap`.
+static inline size_t rideCatalogBuild(uint8_t* out, size_t cap, uint32_t parkId, uint32_t version, uint32_t seq,
+                                      RideCatalogInput* rides, uint16_t n) {
+    size_t stringBytes = 0;
+    for (uint16_t i = 0; i < n; i++) stringBytes += rides[i].nameLen + rides[i].normLen;
+    const size_t tables = sizeof(RideCatalogHeader) + n * sizeof(RideCatalogRecord) + rideCatalogIndexBytes(n);
+    if (tables + stringBytes > cap) return 0;
+
+    std::sort(rides, rides + n, [](const RideCatalogInput& a, const RideCatalogInput& b) { return a.id < b.id; });
+    memset(out, 0, tables);
+    RideCatalogHeader* h = (RideCatalogHeader*)out;
+    h->magic = RIDE_CATALOG_MAGIC;
+    h->parkId = parkId;
+    h->version = version;
+    h->seq = seq;
+    h->count = n;
+    h->stringBytes = (uint32_t)stringBytes;
+
+    RideCatalogRecord* recs = (RideCatalogRecord*)(out + sizeof(RideCatalogHeader));
+    uint16_t* byName = (uint16_t*)(recs + n);
+    char* strings = (char*)(out + tables);
+    uint32_t pos = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        recs[i].id = rides[i].id;
+        recs[i].nameOff = pos;
+        recs[i].nameLen = rides[i].nameLen;
+        memcpy(strings + pos, rides[i].name, rides[i].nameLen);
+        pos += rides[i].nameLen;
+        recs[i].normOff = pos;
+        recs[i].normLen = rides[i].normLen;
+        memcpy(strings + pos, rides[i].norm, rides[i].normLen);
+        pos += rides[i].normLen;
+        byName[i] = i;
+    }
+    std::sort(byName, byName + n, [&](uint16_t a, uint16_t b) {
+        return rideCatalogCompare(strings + recs[a].normOff, recs[a].normLen, strings + recs[b].normOff, recs[b].normLen) < 0;
+    });
+    return tables + stringBytes;
+}
@@ -0,0 +1,155 @@
+// summary_codec.h - Binary /v1/summary format shared with the Worker (summary_codec.js).
+//
+// The Worker serves this instead of JSON when the request carries
+// `Accept: application/x-parkpal-summary` (or hits /v1/summary.bin). It is a fixed-order,
+// little-endian record, so decoding is bounds-checked copies into ParkSummary with no heap use.
+// Any layout change must bump SUMMARY_BIN_VERSION here and in summary_codec.js together; the host
+// round-trip test (host/summary_roundtrip.mjs) encodes with one and decodes with the other. The
+// firmware asks for its version with `Accept: application/x-parkpal-summary; v=2`; without the
+// parameter the Worker keeps serving version 1, which devices on older firmware check for.
+// Version 1 records (an older Worker) still decode, with the cadence fields unknown.
+//
+//   off  size  field
+//   0    4     magic "PPS" + version byte
+//   4    1     units (0 = imperial, 1 = metric)
+//   5    1     ride count (<= SUMMARY_MAX_RIDES)
+//   6    2     weather temp (int16, rounded)
+//   8    2     weather code (OpenWeather condition id)
+//   10   4     sunrise (unix s)
+//   14   4     sunset (unix s)
+//   18   4     updated_at (unix s)
+//   22   2     opens, minutes after local midnight (usual hours; SUMMARY_HOURS_UNKNOWN if none)  v2
+//   24   2     closes, same; may be <= opens when the park closes after midnight                v2
+//   26   1     flags (bit 0 = some ride in the park is open right now)                          v2
+//   27   1     volatility: favourite waits' change since the previous upstream fetch, in        v2
+//              minutes per hour (SUMMARY_VOLATILITY_UNKNOWN if there is no previous fetch)
+//   28   1     desc length n, then n bytes of UTF-8 (n <= SUMMARY_DESC_MAX); at 22 in v1
+//   then per ride:
+//        4     id (uint32)
+//        2     wait_time (int16, minutes)
+//        1     flags (bit 0 = is_open)
+//        1     name length n, then n bytes of UTF-8 (n <= SUMMARY_NAME_MAX)
+//
+// /v1/summary/batch wraps one record per park:
+//
+//   0    4     magic "PPB" + version byte
+//   4    1     park count
+//   then per park:
+//        4     park id (uint32)
+//        2     record length n (uint16), then the n-byte "PPS" record above
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define SUMMARY_BIN_TYPE "application/x-parkpal-summary"
+
+#define SUMMARY_BIN_ACCEPT SUMMARY_BIN_TYPE "; v=2"
+
+static const uint8_t SUMMARY_BIN_VERSION = 2;
+static const size_t SUMMARY_MAX_RIDES = 6;
+static const size_t SUMMARY_DESC_MAX = 47;
+static const size_t SUMMARY_NAME_MAX = 71;
+static const size_t SUMMARY_BIN_HEADER = 29;
+static const size_t SUMMARY_BIN_HEADER_V1 = 23;
+static const uint16_t SUMMARY_HOURS_UNKNOWN = 0xFFFF;
+static const uint8_t SUMMARY_VOLATILITY_UNKNOWN = 0xFF;
+static const size_t SUMMARY_BIN_MAX = SUMMARY_BIN_HEADER + SUMMARY_DESC_MAX + SUMMARY_MAX_RIDES * (8 + SUMMARY_NAME_MAX);
+static const size_t SUMMARY_BATCH_HEADER = 5;
+static const size_t SUMMARY_BATCH_ENTRY_HEADER = 6;
+
+struct RideStatus {
+    int32_t id = 0;
+    int16_t wait = 0;
+    bool open = false;
+    char name[SUMMARY_NAME_MAX + 1] = "";
+};
+
+struct ParkSummary {
+    bool metric = false;
+    int16_t temp = 0;
+    uint16_t code = 0;
+    uint32_t sunrise = 0;
+    uint32_t sunset = 0;
+    uint32_t updated_at = 0;
+    uint16_t opens = SUMMARY_HOURS_UNKNOWN;
+    uint16_t closes = SUMMARY_HOURS_UNKNOWN;
+    bool operating = false;
+    uint8_t volatility = SUMMARY_VOLATILITY_UNKNOWN;
+    char desc[SUMMARY_DESC_MAX + 1] = "";
+    uint8_t rides_n = 0;
+    RideStatus rides[SUMMARY_MAX_RIDES];
+};
+
+static inline uint16_t summaryRd16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t summaryRd32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Copies a length-prefixed string at buf[*pos], advancing *pos. False if it runs past `len`.
+static inline bool summaryRdStr(const uint8_t* buf, size_t len, size_t* pos, char* out, size_t outMax) {
+    if (*pos + 1 > len) return false;
+    const size_t n = buf[*pos];
+    *pos += 1;
+    if (n > outMax || *pos + n > len) return false;
+    memcpy(out, buf + *pos, n);
+    out[n] = '\0';
+    *pos += n;
+    return true;
+}
+
+static inline bool decodeSummaryBin(const uint8_t* buf, size_t len, ParkSummary& out) {
+    if (len < SUMMARY_BIN_HEADER_V1) return false;
+    if (buf[0] != 'P' || buf[1] != 'P' || buf[2] != 'S') return false;
+    const uint8_t version = buf[3];
+    if (version != 1 && version != SUMMARY_BIN_VERSION) return false;
+    if (len < (version == 1 ? SUMMARY_BIN_HEADER_V1 : SUMMARY_BIN_HEADER)) return false;
+    const uint8_t count = buf[5];
+    if (count > SUMMARY_MAX_RIDES) return false;
+    out.metric = buf[4] == 1;
+    out.temp = (int16_t)summaryRd16(buf + 6);
+    out.code = summaryRd16(buf + 8);
+    out.sunrise = summaryRd32(buf + 10);
+    out.sunset = summaryRd32(buf + 14);
+    out.updated_at = summaryRd32(buf + 18);
+    size_t pos = 22;
+    if (version >= 2) {
+        out.opens = summaryRd16(buf + 22);
+        out.closes = summaryRd16(buf + 24);
+        out.operating = (buf[26] & 0x01) != 0;
+        out.volatility = buf[27];
+        pos = 28;
+    } else {
+        out.opens = out.closes = SUMMARY_HOURS_UNKNOWN;
+        out.operating = false;
+        out.volatility = SUMMARY_VOLATILITY_UNKNOWN;
+    }
+    if (!summaryRdStr(buf, len, &pos, out.desc, SUMMARY_DESC_MAX)) return false;
+    for (uint8_t i = 0; i < count; i++) {
+        RideStatus& r = out.rides[i];
+        if (pos + 7 > len) return false;
+        r.id = (int32_t)summaryRd32(buf + pos);
+        r.wait = (int16_t)summaryRd16(buf + pos + 4);
+        r.open = (buf[pos + 6] & 0x01) != 0;
+        pos += 7;
+        if (!summaryRdStr(buf, len, &pos, r.name, SUMMARY_NAME_MAX)) return false;
+    }
+    out.rides_n = count;
+    return pos == len;
+}
+
+static inline bool decodeSummaryBatchHeader(const uint8_t* buf, uint8_t& outCount) {
+    if (buf[0] != 'P' || buf[1] != 'P' || buf[2] != 'B' || (buf[3] != 1 && buf[3] != SUMMARY_BIN_VERSION)) return false;
+    outCount = buf[4];
+    return true;
+}
+
+static inline void decodeSummaryBatchEntryHeader(const uint8_t* buf, uint32_t& outParkId, uint16_t& outLen) {
+    outParkId = summaryRd32(buf);
+    outLen = summaryRd16(buf + 4);
+}
@@ -0,0 +1,81 @@
+// summary_codec.js - Binary summary encoder for the firmware; the decoder is summary_codec.h, which
+// documents the layout. Any layout change must bump SUMMARY_BIN_VERSION here and there together.
+// host/summary_roundtrip.mjs encodes with this module and decodes with the C++ side.
+
+export const SUMMARY_BIN_TYPE = "application/x-parkpal-summary";
+export const SUMMARY_BIN_VERSION = 2;
+export const SUMMARY_MAX_RIDES = 6;
+export const SUMMARY_DESC_MAX = 47;
+export const SUMMARY_NAME_MAX = 71;
+
+export const UTF8 = new TextEncoder();
+
+// UTF-8 bytes of `s`, cut to at most `max` bytes without splitting a code point
+function utf8Clipped(s, max) {
+  const bytes = UTF8.encode(String(s || ""));
+  if (bytes.length <= max) return bytes;
+  let n = max;
+  while (n > 0 && (bytes[n] & 0xc0) === 0x80) n--;
+  return bytes.subarray(0, n);
+}
+
+// Version 1 lacks the cadence fields (offsets 22-27); it is what firmware that predates them expects.
+export function encodeSummaryBin(units, updatedAt, rides, weather, cadence, version = SUMMARY_BIN_VERSION) {
+  const list = (rides || []).slice(0, SUMMARY_MAX_RIDES);
+  const desc = utf8Clipped(weather?.desc, SUMMARY_DESC_MAX);
+  const names = list.map(r => utf8Clipped(r.name || "Unknown Ride", SUMMARY_NAME_MAX));
+  const header = version >= 2 ? 29 : 23;
+  const size = header + desc.length + names.reduce((n, b) => n + 8 + b.length, 0);
+
+  const buf = new Uint8Array(size);
+  const dv = new DataView(buf.buffer);
+  const clampI16 = (v) => Math.max(-32768, Math.min(32767, Math.round(Number(v) || 0)));
+  const u32 = (v) => Math.max(0, Math.min(0xffffffff, Math.floor(Number(v) || 0)));
+
+  buf.set([0x50, 0x50, 0x53, version], 0); // "PPS" + version
+  buf[4] = units === "metric" ? 1 : 0;
+  buf[5] = list.length;
+  dv.setInt16(6, clampI16(weather?.temp), true);
+  dv.setUint16(8, Math.max(0, Math.min(0xffff, Number(weather?.code) || 0)), true);
+  dv.setUint32(10, u32(weather?.sunrise), true);
+  dv.setUint32(14, u32(weather?.sunset), true);
+  dv.setUint32(18, u32(Date.parse(updatedAt) / 1000), true);
+  let pos = 22;
+  if (version >= 2) {
+    dv.setUint16(22, cadence?.hours ? cadence.hours.opens : 0xffff, true);
+    dv.setUint16(24, cadence?.hours ? cadence.hours.closes : 0xffff, true);
+    buf[26] = cadence?.operating ? 1 : 0;
+    buf[27] = cadence?.volatility == null ? 0xff : Math.min(254, cadence.volatility);
+    pos = 28;
+  }
+  buf[pos++] = desc.length;
+  buf.set(desc, pos);
+  pos += desc.length;
+
+  list.forEach((r, i) => {
+    dv.setUint32(pos, u32(r.id), true);
+    dv.setInt16(pos + 4, clampI16(r.wait_time), true);
+    buf[pos + 6] = r.is_open ? 1 : 0;
+    buf[pos + 7] = names[i].length;
+    buf.set(names[i], pos + 8);
+    pos += 8 + names[i].length;
+  });
+  return buf;
+}
+
+// "PPB" + version, park count, then per park: u32 id, u16 record length, PPS record
+export function encodeSummaryBatchBin(units, parks, version = SUMMARY_BIN_VERSION) {
+  const records = parks.map(p => encodeSummaryBin(units, p.updated_at, p.rides, p.weather, p.cadence, version));
+  const buf = new Uint8Array(5 + records.reduce((n, r) => n + 6 + r.length, 0));
+  const dv = new DataView(buf.buffer);
+  buf.set([0x50, 0x50, 0x42, version], 0);
+  buf[4] = parks.length;
+  let pos = 5;
+  records.forEach((r, i) => {
+    dv.setUint32(pos, parks[i].id, true);
+    dv.setUint16(pos + 4, r.length, true);
+    buf.set(r, pos + 6);
+    pos += 6 + r.length;
+  });
+  return buf;
+}
@@ -0,0 +1,138 @@
+// text_metrics.h - Cached per-font glyph metrics, string measurement and width clipping.
+//
+// Adafruit_GFX::getTextBounds() walks the font's PROGMEM glyph table on every call, and the old
+// clipper trimmed one character at a time and re-measured the whole string each time (quadratic in
+// the name length). FontMetrics copies the advance/offset/width of every glyph into a small RAM
+// table once per font. Strings are then measured in one pass, and clipTextLength() binary-searches
+// prefix sums for the longest prefix that fits. Results match getTextBounds() for single-line text
+// at text size 1, which is all ParkPal draws.
+
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <stdint.h>
+#include <string.h>
+
+struct FontMetrics {
+    const GFXfont* font = nullptr;
+    uint8_t first = 0;
+    uint8_t last = 0;
+    int16_t hgHeight = 0; // Height of "Hg" (ascender to descender), as lineHeight() uses
+    int16_t yMin = 0;     // Top/bottom of the tallest glyphs relative to the baseline, for bounding boxes
+    int16_t yMax = 0;
+    uint8_t adv[95];
+    int8_t xo[95];
+    uint8_t w[95];
+    int8_t yo[95];
+    uint8_t h[95];
+};
+
+// Horizontal extent of a run, pen starting at 0. Empty when maxx < minx.
+struct TextExtent {
+    int16_t minx = INT16_MAX;
+    int16_t maxx = INT16_MIN;
+    int16_t adv = 0;
+
+    int16_t width() const { return maxx >= minx ? maxx - minx + 1 : 0; }
+};
+
+static const size_t TEXT_METRICS_MAX_CHARS = 255; // Longer strings are measured/clipped on the first 255
+
+static inline void fontMetricsBuild(FontMetrics& m, const GFXfont* f) {
+    m.font = f;
+    m.first = (uint8_t)pgm_read_word(&f->first);
+    const uint16_t last = pgm_read_word(&f->last);
+    m.last = (uint8_t)(last > 0x7E ? 0x7E : last);
+    memset(m.adv, 0, sizeof(m.adv));
+    memset(m.xo, 0, sizeof(m.xo));
+    memset(m.w, 0, sizeof(m.w));
+    memset(m.yo, 0, sizeof(m.yo));
+    memset(m.h, 0, sizeof(m.h));
+    const GFXglyph* glyphs = (const GFXglyph*)pgm_read_ptr(&f->glyph);
+    int16_t miny = INT16_MAX, maxy = INT16_MIN;
+    m.yMin = 0;
+    m.yMax = 0;
+    for (uint16_t c = m.first < 0x20 ? 0x20 : m.first; c <= m.last; c++) {
+        const GFXglyph* g = glyphs + (c - m.first);
+        const uint8_t slot = c - 0x20;
+        m.adv[slot] = pgm_read_byte(&g->xAdvance);
+        m.xo[slot] = (int8_t)pgm_read_byte(&g->xOffset);
+        m.w[slot] = pgm_read_byte(&g->width);
+        const int8_t yo = (int8_t)pgm_read_byte(&g->yOffset);
+        const uint8_t h = pgm_read_byte(&g->height);
+        m.yo[slot] = yo;
+        m.h[slot] = h;
+        if (!h) continue;
+        if (yo < m.yMin) m.yMin = yo;
+        if (yo + h - 1 > m.yMax) m.yMax = yo + h - 1;
+        if (c == 'H' || c == 'g') {
+            if (yo < miny) miny = yo;
+            if (yo + h - 1 > maxy) maxy = yo + h - 1;
+        }
+    }
+    m.hgHeight = maxy >= miny ? maxy - miny + 1 : 0;
+}
+
+// Adds character `c` to a run, like Adafruit_GFX::charBounds(); characters outside the font are skipped.
+static inline void textExtentAdd(const FontMetrics& m, TextExtent& e, uint8_t c) {
+    if (c < m.first || c > m.last || c < 0x20) return;
+    const uint8_t slot = c - 0x20;
+    const int16_t x1 = e.adv + m.xo[slot];
+    const int16_t x2 = x1 + m.w[slot] - 1;
+    if (x1 < e.minx) e.minx = x1;
+    if (x2 > e.maxx) e.maxx = x2;
+    e.adv += m.adv[slot];
+}
+
+static inline TextExtent textExtent(const FontMetrics& m, const char* s, size_t n) {
+    TextExtent e;
+    for (size_t i = 0; i < n; i++) textExtentAdd(m, e, (uint8_t)s[i]);
+    return e;
+}
+
+// Rows a run's glyphs cover, relative to the baseline, like the y1/h of getTextBounds(). Unlike
+// FontMetrics::yMin/yMax (the tallest glyphs of the font), this is the ink of `s` itself. False when
+// no character of `s` is in the font.
+static inline bool textRows(const FontMetrics& m, const char* s, size_t n, int16_t& top, int16_t& bottom) {
+    top = INT16_MAX;
+    bottom = INT16_MIN;
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t c = (uint8_t)s[i];
+        if (c < m.first || c > m.last || c < 0x20) continue;
+        const uint8_t slot = c - 0x20;
+        if (m.yo[slot] < top) top = m.yo[slot];
+        if (m.yo[slot] + m.h[slot] - 1 > bottom) bottom = m.yo[slot] + m.h[slot] - 1;
+    }
+    return bottom >= top;
+}
+
+// Extent of `a` followed by `b`.
+static inline TextExtent textExtentJoin(const TextExtent& a, const TextExtent& b) {
+    TextExtent e = a;
+    if (b.maxx >= b.minx) {
+        if (a.adv + b.minx < e.minx) e.minx = a.adv + b.minx;
+        if (a.adv + b.maxx > e.maxx) e.maxx = a.adv + b.maxx;
+    }
+    e.adv = a.adv + b.adv;
+    return e;
+}
+
+// Longest prefix of s[0..n) (at least 1 byte) whose width, followed by `suffix`, fits in maxW.
+// The caller has already checked that the whole string doesn't fit.
+static inline size_t clipTextLength(const FontMetrics& m, const char* s, size_t n, int16_t maxW, const char* suffix) {
+    if (n > TEXT_METRICS_MAX_CHARS) n = TEXT_METRICS_MAX_CHARS;
+    const TextExtent tail = textExtent(m, suffix, strlen(suffix));
+    TextExtent prefix[TEXT_METRICS_MAX_CHARS + 1];
+    for (size_t i = 0; i < n; i++) {
+        prefix[i + 1] = prefix[i];
+        textExtentAdd(m, prefix[i + 1], (uint8_t)s[i]);
+    }
+    // Width only grows with the prefix length, so binary search for the last fitting prefix.
+    size_t lo = 1, hi = n;
+    while (lo < hi) {
+        const size_t mid = (lo + hi + 1) / 2;
+        if (textExtentJoin(prefix[mid], tail).width() <= maxW) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
@@ -0,0 +1,218 @@
+// tz_rule.h - POSIX TZ strings compiled once into offsets and DST rules, for UTC -> local time.
+//
+// newlib converts only through the TZ environment variable, so every conversion in a configured zone
+// meant setenv() + tzset() (re-parsing the string under the environment lock), and the same again
+// to restore it, with the temporary zone visible to every other task. tzRuleParse() parses the
+// string once; tzOffsetAt() and tzLocalDate() then convert without touching global state. Accepts
+// what newlib accepts:
+//
+//   std offset [dst [offset] [,start[/time],end[/time]]]
+//
+// with names alphabetic or <quoted>, offsets and times [+-]hh[:mm[:ss]], and dates Mm.w.d, Jn
+// (1..365, Feb 29 never counted) or n (0..365). As in newlib, a DST zone without a rule uses the US
+// one (M3.2.0,M11.1.0), and the transitions are those of the UTC year of the instant converted.
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+struct TzDate {
+    char kind = 'M';       // 'M' month.week.weekday, 'J' Julian day without Feb 29, 'D' zero-based day
+    uint16_t day = 0;      // J/D
+    uint8_t month = 0;     // M: 1..12
+    uint8_t week = 0;      // M: 1..5, 5 = last
+    uint8_t weekday = 0;   // M: 0 = Sunday
+    int32_t secs = 7200;   // Local time of the transition (in the offset in effect before it)
+};
+
+struct TzRule {
+    int32_t stdOff = 0; // Seconds east of UTC
+    int32_t dstOff = 0;
+    bool hasDst = false;
+    TzDate start;
+    TzDate end;
+};
+
+// Days since 1970-01-01 for a civil date, and back.
+static inline int32_t tzDaysFromCivil(int y, unsigned m, unsigned d) {
+    y -= (m <= 2);
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = (unsigned)(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (int32_t)(era * 146097 + (int)doe - 719468);
+}
+
+static inline void tzCivilFromDays(int32_t z, int& y, int& m, int& d) {
+    z += 719468;
+    const int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const uint32_t doe = (uint32_t)(z - era * 146097);
+    const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const uint32_t mp = (5 * doy + 2) / 153;
+    d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    y = (int)yoe + era * 400 + (m <= 2);
+}
+
+static inline int64_t tzFloorDiv(int64_t a, int64_t b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+static inline bool tzLeapYear(int y) {
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+
+static inline bool tzParseName(const char*& p) {
+    const char* q = p;
+    if (*p == '<') {
+        q = ++p;
+        while (*p && *p != '>') p++;
+        if (*p != '>' || p - q < 3) return false;
+        p++;
+        return true;
+    }
+    while ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z')) p++;
+    return p - q >= 3;
+}
+
+static inline bool tzParseNum(const char*& p, int lo, int hi, int& out) {
+    if (*p < '0' || *p > '9') return false;
+    int v = 0;
+    while (*p >= '0' && *p <= '9' && v <= hi) v = v * 10 + (*p++ - '0');
+    out = v;
+    return v >= lo && v <= hi;
+}
+
+// [+-]hh[:mm[:ss]] in seconds.
+static inline bool tzParseTime(const char*& p, int32_t& out) {
+    int sign = 1;
+    if (*p == '+' || *p == '-') sign = *p++ == '-' ? -1 : 1;
+    int h = 0, m = 0, s = 0;
+    if (!tzParseNum(p, 0, 167, h)) return false;
+    if (*p == ':') {
+        p++;
+        if (!tzParseNum(p, 0, 59, m)) return false;
+        if (*p == ':') {
+            p++;
+            if (!tzParseNum(p, 0, 59, s)) return false;
+        }
+    }
+    out = sign * (h * 3600 + m * 60 + s);
+    return true;
+}
+
+static inline bool tzParseDate(const char*& p, TzDate& d) {
+    d = TzDate();
+    int a = 0, b = 0, c = 0;
+    if (*p == 'M') {
+        p++;
+        if (!tzParseNum(p, 1, 12, a) || *p++ != '.' || !tzParseNum(p, 1, 5, b) || *p++ != '.' || !tzParseNum(p, 0, 6, c))
+            return false;
+        d.month = (uint8_t)a;
+        d.week = (uint8_t)b;
+        d.weekday = (uint8_t)c;
+    } else if (*p == 'J') {
+        p++;
+        if (!tzParseNum(p, 1, 365, a)) return false;
+        d.kind = 'J';
+        d.day = (uint16_t)a;
+    } else {
+        if (!tzParseNum(p, 0, 365, a)) return false;
+        d.kind = 'D';
+        d.day = (uint16_t)a;
+    }
+    if (*p == '/') {
+        p++;
+        if (!tzParseTime(p, d.secs)) return false;
+    }
+    return true;
+}
+
+static inline void tzUsRule(TzDate& start, TzDate& end) {
+    start = TzDate();
+    start.month = 3;
+    start.week = 2;
+    end = TzDate();
+    end.month = 11;
+    end.week = 1;
+}
+
+// Parses a POSIX TZ string. On failure `r` is left as UTC (newlib's fallback) and false returned.
+static inline bool tzRuleParse(const char* s, TzRule& r) {
+    r = TzRule();
+    if (!s) return false;
+    const char* p = s;
+    int32_t off = 0;
+    if (!tzParseName(p) || !tzParseTime(p, off)) return false;
+    TzRule out;
+    out.stdOff = -off; // POSIX offsets are west of UTC
+    if (*p) {
+        if (!tzParseName(p)) return false;
+        out.hasDst = true;
+        out.dstOff = out.stdOff + 3600;
+        if (*p && *p != ',') {
+            if (!tzParseTime(p, off)) return false;
+            out.dstOff = -off;
+        }
+        tzUsRule(out.start, out.end);
+        if (*p == ',') {
+            p++;
+            if (!tzParseDate(p, out.start) || *p++ != ',' || !tzParseDate(p, out.end)) return false;
+        }
+        if (*p) return false;
+    }
+    r = out;
+    return true;
+}
+
+// Days since 1970-01-01 of a transition date in `year`.
+static inline int32_t tzDateDay(const TzDate& d, int year) {
+    const int32_t jan1 = tzDaysFromCivil(year, 1, 1);
+    if (d.kind == 'J') return jan1 + d.day - 1 + (tzLeapYear(year) && d.day >= 60);
+    if (d.kind == 'D') return jan1 + d.day;
+    const int32_t first = tzDaysFromCivil(year, d.month, 1);
+    const int32_t next = d.month == 12 ? tzDaysFromCivil(year + 1, 1, 1) : tzDaysFromCivil(year, d.month + 1, 1);
+    const int firstWeekday = (int)((first % 7 + 11) % 7); // 1970-01-01 was a Thursday
+    int32_t day = first + (d.weekday - firstWeekday + 7) % 7 + (d.week - 1) * 7;
+    while (day >= next) day -= 7; // Week 5: the last such weekday
+    return day;
+}
+
+// UTC instant of the start (DST begins) or end transition in `year`; the rule must have DST.
+static inline int64_t tzTransitionUtc(const TzRule& r, int year, bool start) {
+    const TzDate& d = start ? r.start : r.end;
+    return (int64_t)tzDateDay(d, year) * 86400 + d.secs - (start ? r.stdOff : r.dstOff);
+}
+
+// Seconds east of UTC in effect at UTC instant t.
+static inline int32_t tzOffsetAt(const TzRule& r, int64_t t) {
+    if (!r.hasDst) return r.stdOff;
+    int y, m, d;
+    tzCivilFromDays((int32_t)tzFloorDiv(t, 86400), y, m, d);
+    const int64_t start = tzTransitionUtc(r, y, true);
+    const int64_t end = tzTransitionUtc(r, y, false);
+    const bool dst = start < end ? (t >= start && t < end) : !(t >= end && t < start);
+    return dst ? r.dstOff : r.stdOff;
+}
+
+// Local calendar date and time of day (seconds) at UTC instant t.
+static inline void tzLocalDate(const TzRule& r, int64_t t, int& y, int& m, int& d, int32_t* secsOfDay = nullptr) {
+    const int64_t local = t + tzOffsetAt(r, t);
+    const int64_t days = tzFloorDiv(local, 86400);
+    tzCivilFromDays((int32_t)days, y, m, d);
+    if (secsOfDay) *secsOfDay = (int32_t)(local - days * 86400);
+}
+
+// First UTC instant after t at which the local date is no longer the date at t (local midnight, or
+// the end of a DST gap that swallows it).
+static inline int64_t tzNextLocalMidnight(const TzRule& r, int64_t t) {
+    int y, m, d;
+    tzLocalDate(r, t, y, m, d);
+    const int64_t midnight = (int64_t)(tzDaysFromCivil(y, m, d) + 1) * 86400; // Local wall time
+    int64_t u = midnight - tzOffsetAt(r, midnight - r.stdOff);
+    u = midnight - tzOffsetAt(r, u);
+    while (u + tzOffsetAt(r, u) < midnight) u += midnight - (u + tzOffsetAt(r, u));
+    return u;
+}
@@ -2,16 +2,33 @@
 // Park registry sourced from parks.json (Orlando + California + Tokyo)
 
 import parksRegistry from "./parks.json";
+import { SUMMARY_BIN_TYPE, SUMMARY_BIN_VERSION, UTF8, encodeSummaryBin, encodeSummaryBatchBin } from "./summary_codec.js";
 
 // --- Tunables (can override via env vars if you want) ---
 const DEFAULT_TIMEOUT_MS = 4000; // 4s
-const CACHE_TTL_SECONDS = 1800;  // 30 minutes
+const CACHE_TTL_SECONDS = 1800;  // 30 minutes, the firmware's REFRESH_MS
+const SUMMARY_TTL_FAST_SECONDS = 600; // The firmware's REFRESH_FAST_MS (see summaryTtlSeconds())
+const SUMMARY_TTL_CLOSED_MAX_SECONDS = 21600; // The firmware's REFRESH_CLOSED_MAX_MS
+const SUMMARY_TTL_MIN_SECONDS = 60;
+const SUMMARY_TTL_NO_RIDES_SECONDS = 60; // Queue-Times failed: retry soon rather than serve no rides
+const ROPE_DROP_LEAD_MINUTES = 30;    // Around opening, summaries refresh fast from this long before...
+const ROPE_DROP_WINDOW_MINUTES = 90;  // ...until this long after it
+const VOLATILITY_FAST_MIN_PER_H = 20; // Waits moving this fast refresh fast
 const RIDES_CACHE_TTL_SECONDS = 86400; // 24 hours
-const CACHE_VERSION = "v1";
+const WAITS_HISTORY_TTL_SECONDS = 10800; // 3 hours: older samples say nothing about the current trend
+const WAITS_HISTORY_MIN_AGE_SECONDS = 600; // Closer samples are too noisy to rate
+const CACHE_VERSION = "v2";
+const FILL_LOCK_TTL_SECONDS = 15; // Outlives one summary fill (two parallel fetches at the upstream timeout)
+const FILL_LOCK_WAIT_MS = 6000;   // A miss waits this long for another isolate's fill before fetching itself
+const FILL_LOCK_POLL_MS = 250;
+const BATCH_MAX_PARKS = 4; // Matches the firmware's park rotation
 
 // In-isolate hot cache (avoids even Cache API lookups when the Worker stays warm)
 const MEM_CACHE = new Map(); // key -> { expiresAtMs, payload }
 
+// Upstream fills in progress in this isolate (see singleFlight())
+const PENDING = new Map(); // cache key -> Promise
+
 // Flat park lookup from parks.json registry
 const REGISTRY_PARKS = new Map();
 for (const dest of parksRegistry.destinations) {
@@ -48,11 +65,10 @@ export default {
         errors: Array.isArray(p.errors) ? p.errors : []
       } : { present: false };
 
+      // One summary per park now serves both unit systems
       const parks = {};
       for (const [parkId] of REGISTRY_PARKS) {
-        const imp = await cacheGetParkSummary(parkId, "imperial");
-        const met = await cacheGetParkSummary(parkId, "metric");
-        parks[parkId] = { imperial: describe(imp), metric: describe(met) };
+        parks[parkId] = describe(await cacheGetParkSummary(parkId));
       }
       return json({ now: new Date(now).toISOString(), parks }, 0, { "x-request-id": requestId, ...CORS });
     }
@@ -71,24 +87,28 @@ export default {
         return json({ error: "bad_request", details: "unknown park" }, 0, { status: 400, "x-request-id": requestId, ...CORS });
       }
 
-      // Try rides cache first (24h TTL)
-      let cached = await cacheGetRides(parkId);
-      if (cached) {
-        return json(cached, 60, { "x-request-id": requestId, ...CORS });
-      }
-
-      // Fetch live from Queue-Times
-      const payload = await fetchAndCacheRides(env, parkId, parkEntry);
+      // Try rides cache first (24h TTL), then derive it from the park's summary
+      const payload = (await cacheGetRides(parkId)) || (await ridesFromSummary(env, parkId, parkEntry));
       if (!payload) {
         return json({ error: "upstream_error" }, 0, { status: 503, "x-request-id": requestId, ...CORS });
       }
-      return json(payload, 60, { "x-request-id": requestId, ...CORS });
+
+      // The firmware keeps the catalog in flash and only rewrites it when this version changes.
+      const version = ridesCatalogVersion(payload.rides);
+      const etag = `"c${version.toString(16).padStart(8, "0")}"`;
+      if (etagMatches(req.headers.get("if-none-match"), etag)) {
+        return notModified(etag, { "x-request-id": requestId, ...CORS });
+      }
+      return json({ ...payload, version }, 60, { "etag": etag, "x-request-id": requestId, ...CORS });
     }
 
     // --- Main endpoint: summary for one park
     // POST /v1/summary
     // Body: { park: 274, units?: "metric"|"imperial", favorite_ride_ids: [123, 456, ...] }
-    if (req.method === "POST" && url.pathname === "/v1/summary") {
+    // Binary response (summary_codec.h) via `Accept: application/x-parkpal-summary` or POST /v1/summary.bin
+    if (req.method === "POST" && (url.pathname === "/v1/summary" || url.pathname === "/v1/summary.bin")) {
+      const wantBin = url.pathname === "/v1/summary.bin" || (req.headers.get("accept") || "").includes(SUMMARY_BIN_TYPE);
+      const binVersion = summaryBinVersion(req.headers.get("accept"));
       let body = {};
       try { body = await req.json(); }
       catch (_) {
@@ -115,40 +135,130 @@ export default {
       const units = normUnits(body.units);
       const favs = new Set(body.favorite_ride_ids.map(Number).filter(Number.isInteger));
 
-      // Try per-park summary cache (30 min TTL)
-      let cacheWasHit = false;
-      let payload = await cacheGetParkSummary(parkId, units);
-
-      if (payload) {
-        cacheWasHit = true;
-      } else {
-        payload = await fetchParkSummary(env, parkId, parkEntry, units);
-      }
+      // Try per-park summary cache (TTL follows the park's cadence)
+      const { payload, cacheWasHit } = await getParkSummary(env, parkId, parkEntry);
 
       if (!payload) {
         return json({ error: "upstream_error" }, 0, { status: 503, "x-request-id": requestId, ...CORS });
       }
 
-      // Filter rides to favorites (empty favorites → empty rides)
-      const rides = favs.size
-        ? (payload.rides || []).filter(r => favs.has(Number(r.id)))
-        : [];
+      const rides = favoriteRides(payload, favs);
+      const weather = weatherIn(payload.weather, units);
+      const cadence = parkCadence(parkEntry, payload, rides);
+
+      // Conditional refresh: unchanged favourites + weather + cadence hints → 304 with no body
+      const etag = await summaryEtag(units, [{ id: parkId, rides, weather, cadence }], wantBin && binVersion);
+      if (etagMatches(req.headers.get("if-none-match"), etag)) {
+        return notModified(etag, { "x-request-id": requestId, ...CORS });
+      }
+
+      if (wantBin) {
+        return binary(encodeSummaryBin(units, payload.updated_at, rides, weather, cadence, binVersion), 60, {
+          "etag": etag,
+          "x-parkpal-cache": cacheWasHit ? "HIT" : "MISS",
+          "x-request-id": requestId,
+          ...CORS
+        });
+      }
 
       return json({
         updated_at: payload.updated_at,
         server_time: new Date().toISOString(),
         units,
         park: { id: parkId, name: parkEntry.name, rides },
-        weather: payload.weather,
+        weather,
+        ...cadenceJson(cadence),
         errors: payload.errors || [],
         source: cacheWasHit ? "cache" : "live"
       }, 60, {
+        "etag": etag,
         "x-parkpal-cache": cacheWasHit ? "HIT" : "MISS",
         "x-request-id": requestId,
         ...CORS
       });
     }
 
+    // --- Batched summaries: every park a device rotates through, in one round trip
+    // POST /v1/summary/batch
+    // Body: { units?: "metric"|"imperial", parks: [{ park: 6, favorite_ride_ids: [...] }, ...] }
+    // Binary response (summary_codec.h, "PPB") via `Accept: application/x-parkpal-summary`
+    if (req.method === "POST" && url.pathname === "/v1/summary/batch") {
+      const wantBin = (req.headers.get("accept") || "").includes(SUMMARY_BIN_TYPE);
+      const binVersion = summaryBinVersion(req.headers.get("accept"));
+      let body = {};
+      try { body = await req.json(); }
+      catch (_) {
+        return json({ error: "bad_request", details: "invalid JSON" }, 0, { status: 400, "x-request-id": requestId, ...CORS });
+      }
+
+      if (!Array.isArray(body.parks) || body.parks.length === 0) {
+        return json({ error: "bad_request", details: "missing parks" }, 0, { status: 400, "x-request-id": requestId, ...CORS });
+      }
+      if (body.parks.length > BATCH_MAX_PARKS) {
+        return json({ error: "bad_request", details: "too many parks" }, 0, { status: 400, "x-request-id": requestId, ...CORS });
+      }
+
+      const units = normUnits(body.units);
+      const wanted = [];
+      for (const p of body.parks) {
+        const parkId = Number(p?.park);
+        const parkEntry = REGISTRY_PARKS.get(parkId);
+        if (!Number.isInteger(parkId) || !parkEntry) {
+          return json({ error: "bad_request", details: "unknown park" }, 0, { status: 400, "x-request-id": requestId, ...CORS });
+        }
+        const ids = Array.isArray(p.favorite_ride_ids) ? p.favorite_ride_ids : [];
+        if (ids.length > 6) {
+          return json({ error: "bad_request", details: "too many favorite_ride_ids" }, 0, { status: 400, "x-request-id": requestId, ...CORS });
+        }
+        wanted.push({ parkId, parkEntry, favs: new Set(ids.map(Number).filter(Number.isInteger)) });
+      }
+
+      const results = await Promise.all(wanted.map(w => getParkSummary(env, w.parkId, w.parkEntry)));
+      if (results.some(r => !r.payload)) {
+        return json({ error: "upstream_error" }, 0, { status: 503, "x-request-id": requestId, ...CORS });
+      }
+
+      const parks = wanted.map((w, i) => {
+        const rides = favoriteRides(results[i].payload, w.favs);
+        return {
+          id: w.parkId,
+          name: w.parkEntry.name,
+          updated_at: results[i].payload.updated_at,
+          rides,
+          weather: weatherIn(results[i].payload.weather, units),
+          cadence: parkCadence(w.parkEntry, results[i].payload, rides),
+          errors: results[i].payload.errors || []
+        };
+      });
+      const allHit = results.every(r => r.cacheWasHit);
+
+      const etag = await summaryEtag(units, parks, wantBin && binVersion);
+      if (etagMatches(req.headers.get("if-none-match"), etag)) {
+        return notModified(etag, { "x-request-id": requestId, ...CORS });
+      }
+
+      if (wantBin) {
+        return binary(encodeSummaryBatchBin(units, parks, binVersion), 60, {
+          "etag": etag,
+          "x-parkpal-cache": allHit ? "HIT" : "MISS",
+          "x-request-id": requestId,
+          ...CORS
+        });
+      }
+
+      return json({
+        server_time: new Date().toISOString(),
+        units,
+        parks: parks.map(({ cadence, ...p }) => ({ ...p, ...cadenceJson(cadence) })),
+        source: allHit ? "cache" : "live"
+      }, 60, {
+        "etag": etag,
+        "x-parkpal-cache": allHit ? "HIT" : "MISS",
+        "x-request-id": requestId,
+        ...CORS
+      });
+    }
+
     // --- Destinations (canonical) + regions (deprecated alias, same payload)
     if (req.method === "GET" && (url.pathname === "/v1/destinations" || url.pathname === "/v1/regions")) {
       const destinations = parksRegistry.destinations.map(d => ({
@@ -188,14 +298,10 @@ function parseUpdatedAtMs(payload) {
   return Number.isFinite(ms) ? ms : null;
 }
 
-// --- Rides cache (24h TTL) ---
-
-function ridesCacheKey(parkId) {
-  return `https://cache.parkpal.fun/${CACHE_VERSION}/rides?park=${parkId}`;
-}
+// --- Edge cache: MEM_CACHE in front of the Cache API; entries expire ttlSeconds after updated_at ---
+// ttlSeconds is a number, or a function of the payload for entries whose lifetime depends on it.
 
-async function cacheGetRides(parkId) {
-  const key = ridesCacheKey(parkId);
+async function cacheGetJson(key, ttlSeconds) {
   const now = Date.now();
 
   const mem = MEM_CACHE.get(key);
@@ -210,7 +316,8 @@ async function cacheGetRides(parkId) {
     const payload = await resp.json();
     const updatedAtMs = parseUpdatedAtMs(payload);
     if (!updatedAtMs) return null;
-    const expiresAtMs = updatedAtMs + RIDES_CACHE_TTL_SECONDS * 1000;
+    const ttl = typeof ttlSeconds === "function" ? ttlSeconds(payload) : ttlSeconds;
+    const expiresAtMs = updatedAtMs + ttl * 1000;
     if (expiresAtMs <= now) return null;
     MEM_CACHE.set(key, { expiresAtMs, payload });
     return payload;
@@ -219,170 +326,407 @@ async function cacheGetRides(parkId) {
   }
 }
 
-async function cachePutRides(parkId, payload) {
-  const key = ridesCacheKey(parkId);
-  MEM_CACHE.set(key, { expiresAtMs: Date.now() + RIDES_CACHE_TTL_SECONDS * 1000, payload });
+async function cachePutJson(key, ttlSeconds, payload) {
+  MEM_CACHE.set(key, { expiresAtMs: Date.now() + ttlSeconds * 1000, payload });
   const resp = new Response(JSON.stringify(payload), {
     headers: {
       "content-type": "application/json; charset=utf-8",
-      "cache-control": `public, max-age=${RIDES_CACHE_TTL_SECONDS}`
+      "cache-control": `public, max-age=${ttlSeconds}`
     }
   });
   await caches.default.put(new Request(key), resp);
 }
 
-// Fetch rides for a single park from Queue-Times, normalize, and cache
-async function fetchAndCacheRides(env, parkId, parkEntry) {
+// --- Single-flight fills ---
+
+// Runs fn() once per key at a time in this isolate; callers arriving while it is in flight get the
+// same promise (and the same result or error).
+function singleFlight(key, fn) {
+  let pending = PENDING.get(key);
+  if (!pending) {
+    pending = Promise.resolve().then(fn).finally(() => PENDING.delete(key));
+    PENDING.set(key, pending);
+  }
+  return pending;
+}
+
+// Fill locks: a short-lived Cache API marker that tells other isolates in the data center that
+// `key` is being fetched. The Cache API has no atomic insert, so two isolates missing in the same
+// instant can both take it; the lock narrows a herd to a few fills rather than exactly one.
+// Failures only cost the coalescing, never the request.
+function fillLockRequest(key) {
+  return new Request(`${key}&fill_lock=1`);
+}
+
+async function fillLockHeld(key) {
+  try { return !!(await caches.default.match(fillLockRequest(key))); } catch (_) { return false; }
+}
+
+async function fillLockTake(key) {
   try {
+    await caches.default.put(fillLockRequest(key), new Response("1", {
+      headers: { "cache-control": `public, max-age=${FILL_LOCK_TTL_SECONDS}` }
+    }));
+  } catch (_) { }
+}
+
+async function fillLockRelease(key) {
+  try { await caches.default.delete(fillLockRequest(key)); } catch (_) { }
+}
+
+// --- Rides cache (24h TTL) ---
+
+function ridesCacheKey(parkId) {
+  return `https://cache.parkpal.fun/${CACHE_VERSION}/rides?park=${parkId}`;
+}
+
+function cacheGetRides(parkId) {
+  return cacheGetJson(ridesCacheKey(parkId), RIDES_CACHE_TTL_SECONDS);
+}
+
+function cachePutRides(parkId, payload) {
+  return cachePutJson(ridesCacheKey(parkId), RIDES_CACHE_TTL_SECONDS, payload);
+}
+
+// Catalog miss: derive it from the park's summary (whose ingest also refills the catalog)
+async function ridesFromSummary(env, parkId, parkEntry) {
+  const { payload, cacheWasHit } = await getParkSummary(env, parkId, parkEntry);
+  if (!payload?.rides?.length) return null; // Queue-Times failed
+  const catalog = ridesCatalog(parkId, parkEntry, payload.rides);
+  if (cacheWasHit) {
+    try { await cachePutRides(parkId, catalog); } catch (_) { }
+  }
+  return catalog;
+}
+
+function ridesCatalog(parkId, parkEntry, rides) {
+  return {
+    updated_at: new Date().toISOString(),
+    park: { id: parkId, name: parkEntry.name },
+    rides: rides.map(r => ({ id: r.id, name: r.name })),
+    errors: []
+  };
+}
+
+// --- Park summary cache (TTL follows the park's refresh cadence, see summaryTtlSeconds()) ---
+
+// Unit-independent: weather is kept in metric and converted per request (weatherIn())
+function parkSummaryCacheKey(parkId) {
+  return `https://cache.parkpal.fun/${CACHE_VERSION}/summary?park=${parkId}`;
+}
+
+function cacheGetParkSummary(parkId) {
+  return cacheGetJson(parkSummaryCacheKey(parkId), p => p.ttl_s ?? CACHE_TTL_SECONDS);
+}
+
+function cachePutParkSummary(parkId, payload) {
+  return cachePutJson(parkSummaryCacheKey(parkId), payload.ttl_s ?? CACHE_TTL_SECONDS, payload);
+}
+
+// --- Wait history (3h TTL): the previous upstream sample of each park's open-ride waits ---
+
+function waitsHistoryCacheKey(parkId) {
+  return `https://cache.parkpal.fun/${CACHE_VERSION}/waits?park=${parkId}`;
+}
+
+// Stores this fetch's waits and returns the previous sample to rate the trend against. A sample
+// younger than WAITS_HISTORY_MIN_AGE_SECONDS stays in place and gives no trend.
+async function swapWaitsHistory(parkId, rides, updatedAt) {
+  const key = waitsHistoryCacheKey(parkId);
+  const prev = await cacheGetJson(key, WAITS_HISTORY_TTL_SECONDS);
+  if (prev && Date.parse(updatedAt) - parseUpdatedAtMs(prev) < WAITS_HISTORY_MIN_AGE_SECONDS * 1000) return null;
+  const waits = {};
+  for (const r of rides) if (r.is_open) waits[r.id] = r.wait_time;
+  await cachePutJson(key, WAITS_HISTORY_TTL_SECONDS, { updated_at: updatedAt, waits });
+  return prev;
+}
+
+// --- Upstream ingest: each source is fetched once, and every cache entry is derived from it ---
+
+// Live rides for one park from Queue-Times (lands[].rides + top-level rides[]). The ride catalog
+// is refreshed from the same response.
+async function ingestQueueTimes(env, parkId, parkEntry) {
   const j = await fetchJSON(parkEntry.queue_times_url, { headers: { "User-Agent": "ParkPal/1.0" } }, env.UPSTREAM_TIMEOUT_MS);
-    const byId = new Map();
-
-    // Normalize: merge lands[].rides + top-level rides[]
-    if (j && Array.isArray(j.lands)) {
-      for (const land of j.lands) {
-        for (const ride of (land?.rides || [])) {
-          if (!ride || ride.id == null) continue;
-          byId.set(Number(ride.id), { id: Number(ride.id), name: ride.name || "Unknown Ride" });
-        }
-      }
-    }
-    if (j && Array.isArray(j.rides)) {
-      for (const ride of j.rides) {
+  const byId = new Map();
+  const live = (ride) => ({
+    id: Number(ride.id),
+    name: ride.name || "Unknown Ride",
+    is_open: !!ride.is_open,
+    wait_time: Number(ride.wait_time ?? 0)
+  });
+
+  if (j && Array.isArray(j.lands)) {
+    for (const land of j.lands) {
+      for (const ride of (land?.rides || [])) {
         if (!ride || ride.id == null) continue;
-        const id = Number(ride.id);
-        if (!byId.has(id)) byId.set(id, { id, name: ride.name || "Unknown Ride" });
+        byId.set(Number(ride.id), live(ride));
       }
     }
+  }
+  if (j && Array.isArray(j.rides)) {
+    for (const ride of j.rides) {
+      if (!ride || ride.id == null) continue;
+      if (!byId.has(Number(ride.id))) byId.set(Number(ride.id), live(ride));
+    }
+  }
 
-    const payload = {
-      updated_at: new Date().toISOString(),
-      park: { id: parkId, name: parkEntry.name },
-      rides: [...byId.values()],
-      errors: []
-    };
-    try { await cachePutRides(parkId, payload); } catch (_) { }
-    return payload;
-  } catch (_) {
-    return null;
+  const rides = [...byId.values()];
+  try { await cachePutRides(parkId, ridesCatalog(parkId, parkEntry, rides)); } catch (_) { }
+  return rides;
+}
+
+function weatherCacheKey(coords) {
+  return `https://cache.parkpal.fun/${CACHE_VERSION}/weather?lat=${coords.lat}&lon=${coords.lon}`;
+}
+
+// Current weather at `coords`, in metric, shared by every park there (30 min TTL). Concurrent
+// lookups for the same coordinates (a batch of one resort's parks) wait on one request.
+function ingestWeather(env, coords) {
+  const key = weatherCacheKey(coords);
+  return singleFlight(key, async () => (await cacheGetJson(key, CACHE_TTL_SECONDS))?.weather ?? fetchWeather(env, coords, key));
+}
+
+// OpenWeather condition codes: https://openweathermap.org/weather-conditions
+async function fetchWeather(env, coords, key) {
+  const w = await fetchJSON(
+    `https://api.openweathermap.org/data/2.5/weather?lat=${coords.lat}&lon=${coords.lon}&units=metric&appid=${env.OWM_API_KEY}`,
+    {},
+    env.UPSTREAM_TIMEOUT_MS
+  );
+  const weather = {
+    temp_c: Number(w?.main?.temp ?? 0),
+    desc: (w?.weather?.[0]?.description || "").toLowerCase(),
+    code: Number(w?.weather?.[0]?.id ?? 0) || 0,
+    main: String(w?.weather?.[0]?.main || ""),
+    sunrise: w?.sys?.sunrise ?? 0,
+    sunset: w?.sys?.sunset ?? 0
+  };
+  try { await cachePutJson(key, CACHE_TTL_SECONDS, { updated_at: new Date().toISOString(), weather }); } catch (_) { }
+  return weather;
+}
+
+// Weather as shown in `units`: ingest keeps unrounded Celsius, so both systems round the same reading
+function weatherIn(weather, units) {
+  const { temp_c, ...rest } = weather || { desc: "", code: 0, main: "", sunrise: 0, sunset: 0 };
+  const c = Number(temp_c ?? 0);
+  return { temp: weather ? Math.round(units === "metric" ? c : c * 9 / 5 + 32) : 0, ...rest };
+}
+
+// Fetch rides + weather for one park from upstream (in parallel), and cache the summary
+async function fetchParkSummary(env, parkId, parkEntry) {
+  const errors = [];
+  const upstreamError = (e) => e?.status ? `HTTP_${e.status}` : (e?.message || "error");
+  const [ridesRes, weatherRes] = await Promise.allSettled([
+    ingestQueueTimes(env, parkId, parkEntry),
+    ingestWeather(env, parkEntry.coords)
+  ]);
+
+  let rides = [];
+  if (ridesRes.status === "fulfilled") rides = ridesRes.value;
+  else errors.push(`park_${parkId}_${upstreamError(ridesRes.reason)}`);
+
+  let weather = null;
+  if (weatherRes.status === "fulfilled") weather = weatherRes.value;
+  else errors.push(`weather_${upstreamError(weatherRes.reason)}`);
+
+  // Each ride's wait at the previous fetch (open rides only), for the volatility hint
+  const updatedAt = new Date().toISOString();
+  let prev = null;
+  if (rides.length) {
+    try { prev = await swapWaitsHistory(parkId, rides, updatedAt); } catch (_) { }
   }
+  if (prev) for (const r of rides) r.prev_wait = prev.waits?.[r.id] ?? null;
+
+  const payload = { updated_at: updatedAt, prev_updated_at: prev?.updated_at ?? null, rides, weather, errors };
+  payload.ttl_s = rides.length ? summaryTtlSeconds(parkEntry, payload) : SUMMARY_TTL_NO_RIDES_SECONDS;
+  try { await cachePutParkSummary(parkId, payload); } catch (_) { }
+  return payload;
 }
 
-// --- Park summary cache (30 min TTL) ---
+// Cached summary for one park, fetched from upstream on a miss. When a batch of displays refreshes
+// just after the entry expired, the misses in this isolate share one fill, and misses in other
+// isolates wait for it through the fill lock.
+async function getParkSummary(env, parkId, parkEntry) {
+  const cached = await cacheGetParkSummary(parkId);
+  if (cached) return { payload: cached, cacheWasHit: true };
+  const key = parkSummaryCacheKey(parkId);
+  return singleFlight(key, async () => {
+    // A fill that finished while this miss was looking up the cache has already stored it
+    const filled = await cacheGetParkSummary(parkId);
+    if (filled) return { payload: filled, cacheWasHit: true };
+
+    if (await fillLockHeld(key)) {
+      const deadline = Date.now() + FILL_LOCK_WAIT_MS;
+      while (Date.now() < deadline) {
+        await new Promise(resolve => setTimeout(resolve, FILL_LOCK_POLL_MS));
+        const theirs = await cacheGetParkSummary(parkId);
+        if (theirs) return { payload: theirs, cacheWasHit: true };
+      }
+      // The other fill failed or is stuck: fetch anyway rather than fail the request
+    }
 
-function parkSummaryCacheKey(parkId, units) {
-  return `https://cache.parkpal.fun/${CACHE_VERSION}/summary?park=${parkId}&units=${encodeURIComponent(units)}`;
+    await fillLockTake(key);
+    try {
+      return { payload: await fetchParkSummary(env, parkId, parkEntry), cacheWasHit: false };
+    } finally {
+      await fillLockRelease(key);
+    }
+  });
 }
 
-async function cacheGetParkSummary(parkId, units) {
-  const key = parkSummaryCacheKey(parkId, units);
-  const now = Date.now();
+// Filter rides to favorites (empty favorites → empty rides)
+function favoriteRides(payload, favs) {
+  return favs.size ? (payload.rides || []).filter(r => favs.has(Number(r.id))) : [];
+}
 
-  const mem = MEM_CACHE.get(key);
-  if (mem) {
-    if (mem.expiresAtMs > now) return mem.payload;
-    MEM_CACHE.delete(key);
+// --- Refresh cadence hints (the firmware refreshes faster around opening and while waits move) ---
+
+// "HH:MM" local time → minutes after midnight, or null
+function parseHoursMinutes(s) {
+  const m = /^(\d{1,2}):(\d{2})$/.exec(String(s || ""));
+  if (!m || Number(m[1]) > 24 || Number(m[2]) > 59) return null;
+  return (Number(m[1]) * 60 + Number(m[2])) % 1440;
+}
+
+// Usual hours from parks.json, whether any ride in the park is open right now, and how fast the
+// favourite waits (all open rides if there are no favourites) moved since the previous upstream
+// fetch: the largest change, in minutes per hour, or null without a previous fetch.
+function parkCadence(parkEntry, payload, rides) {
+  const opens = parseHoursMinutes(parkEntry.hours?.open);
+  const closes = parseHoursMinutes(parkEntry.hours?.close);
+  const all = payload.rides || [];
+  const elapsedMs = parseUpdatedAtMs(payload) - Date.parse(payload.prev_updated_at);
+  let volatility = null;
+  if (elapsedMs > 0) {
+    for (const r of (rides.length ? rides : all)) {
+      if (!r.is_open || r.prev_wait == null) continue;
+      const rate = Math.abs(Number(r.wait_time) - Number(r.prev_wait)) * 3600000 / elapsedMs;
+      volatility = Math.max(volatility ?? 0, Math.round(rate));
+    }
   }
+  return {
+    hours: opens != null && closes != null ? { opens, closes } : null,
+    operating: all.some(r => r.is_open),
+    volatility
+  };
+}
 
-  const resp = await caches.default.match(new Request(key));
-  if (!resp) return null;
+// Minutes after local midnight at `ms` in the park's IANA zone (parks.json "time_zone"), or null.
+function parkLocalMinutes(parkEntry, ms) {
+  if (!parkEntry.time_zone || !Number.isFinite(ms)) return null;
   try {
-    const payload = await resp.json();
-    const updatedAtMs = parseUpdatedAtMs(payload);
-    if (!updatedAtMs) return null;
-    const expiresAtMs = updatedAtMs + CACHE_TTL_SECONDS * 1000;
-    if (expiresAtMs <= now) return null;
-    MEM_CACHE.set(key, { expiresAtMs, payload });
-    return payload;
+    const parts = new Intl.DateTimeFormat("en-US", {
+      timeZone: parkEntry.time_zone, hourCycle: "h23", hour: "2-digit", minute: "2-digit"
+    }).formatToParts(new Date(ms));
+    const part = (type) => Number(parts.find(p => p.type === type)?.value);
+    const minutes = part("hour") * 60 + part("minute");
+    return Number.isFinite(minutes) ? minutes : null;
   } catch (_) {
     return null;
   }
 }
 
-async function cachePutParkSummary(parkId, units, payload) {
-  const key = parkSummaryCacheKey(parkId, units);
-  MEM_CACHE.set(key, { expiresAtMs: Date.now() + CACHE_TTL_SECONDS * 1000, payload });
-  const resp = new Response(JSON.stringify(payload), {
-    headers: {
-      "content-type": "application/json; charset=utf-8",
-      "cache-control": `public, max-age=${CACHE_TTL_SECONDS}`
-    }
+// Lifetime of a freshly fetched summary: the step the firmware takes for the park at that moment
+// (parkCadenceMs() in parkpal.ino), so a display never gets data older than its own cadence. Short
+// around opening and while waits move, CACHE_TTL_SECONDS while the park is open or within its
+// hours, and until the next rope-drop window once it is closed.
+function summaryTtlSeconds(parkEntry, payload) {
+  const c = parkCadence(parkEntry, payload, []);
+  const fast = c.volatility != null && c.volatility >= VOLATILITY_FAST_MIN_PER_H;
+  const now = parkLocalMinutes(parkEntry, parseUpdatedAtMs(payload));
+  if (!c.hours || now == null) return c.operating && fast ? SUMMARY_TTL_FAST_SECONDS : CACHE_TTL_SECONDS;
+  const until = (minute) => ((minute - now) % 1440 + 1440) % 1440 || 1440; // 0 < result <= 1 day
+  const untilRopeDrop = until(c.hours.opens - ROPE_DROP_LEAD_MINUTES);
+  if (1440 - untilRopeDrop < ROPE_DROP_LEAD_MINUTES + ROPE_DROP_WINDOW_MINUTES) return SUMMARY_TTL_FAST_SECONDS;
+  if (c.operating) return fast ? SUMMARY_TTL_FAST_SECONDS : CACHE_TTL_SECONDS;
+  const sinceOpening = 1440 - until(c.hours.opens);
+  const hoursLength = (c.hours.closes - c.hours.opens + 1439) % 1440 + 1; // closes <= opens: after midnight
+  if (sinceOpening < hoursLength) return CACHE_TTL_SECONDS;
+  return Math.min(Math.max(untilRopeDrop * 60, SUMMARY_TTL_MIN_SECONDS), SUMMARY_TTL_CLOSED_MAX_SECONDS);
+}
+
+function cadenceJson(c) {
+  const hhmm = (m) => `${String(Math.floor(m / 60)).padStart(2, "0")}:${String(m % 60).padStart(2, "0")}`;
+  return {
+    hours: c.hours ? { open: hhmm(c.hours.opens), close: hhmm(c.hours.closes) } : null,
+    operating: c.operating,
+    volatility: c.volatility
+  };
+}
+
+// --- Conditional refresh (ETag / If-None-Match) ---
+
+// Strong ETag over what the display shows: each park's id, favourite rides, weather and cadence
+// hints, in the binary layout with updated_at zeroed, so a cache refill with identical values keeps
+// the same tag. The representation is part of the tag (JSON, or the binary version; 0 for JSON).
+async function summaryEtag(units, parks, binVersion) {
+  const records = parks.map(p => encodeSummaryBin(units, null, p.rides, p.weather, p.cadence));
+  const all = new Uint8Array(records.reduce((n, r) => n + 4 + r.length, 0));
+  const dv = new DataView(all.buffer);
+  let pos = 0;
+  records.forEach((r, i) => {
+    dv.setUint32(pos, Number(parks[i].id) >>> 0, true);
+    all.set(r, pos + 4);
+    pos += 4 + r.length;
   });
-  await caches.default.put(new Request(key), resp);
+  const digest = new Uint8Array(await crypto.subtle.digest("SHA-256", all));
+  const hex = [...digest.subarray(0, 12)].map(b => b.toString(16).padStart(2, "0")).join("");
+  return `"${hex}-${binVersion ? `b${binVersion}` : "j"}"`;
 }
 
-// Fetch rides + weather for one park from upstream, normalize, and cache
-async function fetchParkSummary(env, parkId, parkEntry, units) {
-  const errors = [];
+// The binary version a request asks for: `; v=2` on the summary type, else 1 (firmware that
+// predates the parameter only accepts version 1).
+function summaryBinVersion(accept) {
+  const m = /application\/x-parkpal-summary\s*;\s*v=(\d+)/.exec(String(accept || ""));
+  return m && Number(m[1]) >= SUMMARY_BIN_VERSION ? SUMMARY_BIN_VERSION : 1;
+}
 
-  // Fetch rides from Queue-Times
-  let rides = [];
-  try {
-  const j = await fetchJSON(parkEntry.queue_times_url, { headers: { "User-Agent": "ParkPal/1.0" } }, env.UPSTREAM_TIMEOUT_MS);
-    const byId = new Map();
-
-    if (j && Array.isArray(j.lands)) {
-      for (const land of j.lands) {
-        for (const ride of (land?.rides || [])) {
-          if (!ride || ride.id == null) continue;
-          byId.set(Number(ride.id), {
-            id: Number(ride.id),
-            name: ride.name || "Unknown Ride",
-            is_open: !!ride.is_open,
-            wait_time: Number(ride.wait_time ?? 0)
-          });
-        }
-      }
-    }
-    if (j && Array.isArray(j.rides)) {
-      for (const ride of j.rides) {
-        if (!ride || ride.id == null) continue;
-        const id = Number(ride.id);
-        if (!byId.has(id)) {
-          byId.set(id, {
-            id,
-            name: ride.name || "Unknown Ride",
-            is_open: !!ride.is_open,
-            wait_time: Number(ride.wait_time ?? 0)
-          });
-        }
-      }
-    }
-    rides = [...byId.values()];
-  } catch (e) {
-    errors.push(`park_${parkId}_${e?.status ? `HTTP_${e.status}` : (e?.message || "error")}`);
-  }
+// If-None-Match may list several tags; a proxy may have weakened ours (W/"...").
+function etagMatches(ifNoneMatch, etag) {
+  if (!ifNoneMatch) return false;
+  const bare = (t) => t.trim().replace(/^W\//, "");
+  return ifNoneMatch.split(",").some(t => t.trim() === "*" || bare(t) === bare(etag));
+}
 
-  // Fetch weather using park-specific coords
-  // OpenWeather condition codes: https://openweathermap.org/weather-conditions
-  let weather = { temp: 0, desc: "", code: 0, main: "", sunrise: 0, sunset: 0 };
-  try {
-    const { lat, lon } = parkEntry.coords;
-    const w = await fetchJSON(
-      `https://api.openweathermap.org/data/2.5/weather?lat=${lat}&lon=${lon}&units=${units}&appid=${env.OWM_API_KEY}`,
-      {},
-      env.UPSTREAM_TIMEOUT_MS
-    );
-    weather = {
-      temp: Math.round(w?.main?.temp ?? 0),
-      desc: (w?.weather?.[0]?.description || "").toLowerCase(),
-      code: Number(w?.weather?.[0]?.id ?? 0) || 0,
-      main: String(w?.weather?.[0]?.main || ""),
-      sunrise: w?.sys?.sunrise ?? 0,
-      sunset: w?.sys?.sunset ?? 0
-    };
-  } catch (e) {
-    errors.push(`weather_${e?.status ? `HTTP_${e.status}` : (e?.message || "error")}`);
+// FNV-1a over the id-sorted (id, name) pairs; never 0, which the firmware reads as "none".
+function ridesCatalogVersion(rides) {
+  const lines = (rides || [])
+    .map(r => ({ id: Number(r.id), name: String(r.name || "") }))
+    .sort((a, b) => a.id - b.id)
+    .map(r => `${r.id}\t${r.name}\n`)
+    .join("");
+  let h = 0x811c9dc5;
+  for (const b of UTF8.encode(lines)) {
+    h ^= b;
+    h = Math.imul(h, 0x01000193) >>> 0;
   }
+  return h || 1;
+}
 
-  const payload = { updated_at: new Date().toISOString(), rides, weather, errors };
-  try { await cachePutParkSummary(parkId, units, payload); } catch (_) { }
-  return payload;
+function notModified(etag, extraHeaders = {}) {
+  return new Response(null, {
+    status: 304,
+    headers: { "etag": etag, "cache-control": "public, max-age=60", ...extraHeaders }
+  });
 }
 
 // --- Shared helpers ---
 
 const normUnits = (u) => (String(u || "imperial").toLowerCase().startsWith("m") ? "metric" : "imperial");
 
+function binary(bytes, maxAge = 60, extraHeaders = {}) {
+  const { status, ...headers } = extraHeaders;
+  return new Response(bytes, {
+    status: status || 200,
+    headers: {
+      "content-type": SUMMARY_BIN_TYPE,
+      "cache-control": `public, max-age=${maxAge}`,
+      "vary": "accept",
+      ...headers
+    }
+  });
+}
+
 function json(data, maxAge = 60, extraHeaders = {}) {
   const { status, ...headers } = extraHeaders;
   return new Response(JSON.stringify(data), {